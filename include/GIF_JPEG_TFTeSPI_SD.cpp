@@ -7,6 +7,7 @@ int32_t GIFReadFile(GIFFILE *pFile, uint8_t *pBuf, int32_t iLen);
 int32_t GIFSeekFile(GIFFILE *pFile, int32_t iPosition);
 void GIFDraw(GIFDRAW *pDraw);
 void play_gif(const char *filename);
+void gifBenchmark();
 void show_jpeg(const char *filename);
 void scanDir(fs::FS &fs, const char *dirname);
 void gifJpegInitialize();
@@ -22,6 +23,77 @@ bool tft_output(int16_t x, int16_t y, uint16_t w, uint16_t h, uint16_t *bitmap)
     return 1;
 }
 
+// ==== GIF line output ====
+// Decoded lines are collected into strips of up to GIF_STRIP_LINES lines under one address window.
+// A full strip goes out by DMA from one half of gifStrip while the decoder fills the other half.
+// The SD card shares the SPI bus, so the transfer is finished and the bus released before every
+// file read and before anything else draws. Lines with transparent pixels still go out run by run
+// (the glass cannot be read back), but in one transaction per line.
+#define GIF_STRIP_LINES 8
+
+uint16_t gifStrip[2][GIF_STRIP_LINES * DISPLAY_WIDTH];
+uint8_t gifHalf = 0;                     // half being filled
+uint8_t gifStripRows = 0;                // lines collected in it
+uint8_t gifStripLimit = GIF_STRIP_LINES; // lines per strip (the benchmark also runs 1)
+int gifStripX, gifStripY, gifStripW;     // window of the collected lines
+bool gifDma = false;                     // initDMA() succeeded
+bool gifBusHeld = false;                 // TFT selected, a DMA transfer may be in flight
+bool gifFrameDelays = true;              // honour the GIF frame times (the benchmark does not)
+
+struct GifStats
+{
+    uint32_t frames;
+    uint32_t bytes;  // pixel bytes sent
+    uint32_t writes; // address windows
+};
+GifStats gifStats;
+
+void gifBusRelease()
+{
+    if (!gifBusHeld)
+        return;
+    tft.dmaWait();
+    tft.endWrite();
+    gifBusHeld = false;
+}
+
+void gifBusHold()
+{
+    if (gifBusHeld)
+        return;
+    tft.startWrite();
+    gifBusHeld = true;
+}
+
+void gifStripSend()
+{
+    if (!gifStripRows)
+        return;
+    gifBusHold();
+    if (gifDma)
+        tft.pushImageDMA(gifStripX, gifStripY, gifStripW, gifStripRows, gifStrip[gifHalf]); // waits for the other half first
+    else
+        tft.pushImage(gifStripX, gifStripY, gifStripW, gifStripRows, gifStrip[gifHalf]);
+    gifStats.bytes += gifStripW * gifStripRows * 2;
+    gifStats.writes++;
+    gifHalf ^= 1;
+    gifStripRows = 0;
+}
+
+// Where the next line goes; a line that does not continue the strip sends it first
+uint16_t *gifStripLine(int x, int y, int w)
+{
+    if (gifStripRows && (x != gifStripX || w != gifStripW || y != gifStripY + gifStripRows))
+        gifStripSend();
+    if (!gifStripRows)
+    {
+        gifStripX = x;
+        gifStripY = y;
+        gifStripW = w;
+    }
+    return gifStrip[gifHalf] + gifStripRows * w;
+}
+
 // ==== AnimatedGIF callbacks (unchanged, except Adafruit→TFT_eSPI calls) ====
 void *GIFOpenFile(const char *fname, int32_t *pSize)
 {
@@ -49,6 +121,7 @@ int32_t GIFReadFile(GIFFILE *pFile, uint8_t *pBuf, int32_t iLen)
     File *f = static_cast<File *>(pFile->fHandle);
     if (!f)
         return 0;
+    gifBusRelease(); // SD and TFT share the bus
     int32_t n = f->read(pBuf, iLen);
     pFile->iPos = f->position();
     return n;
@@ -57,6 +130,7 @@ int32_t GIFReadFile(GIFFILE *pFile, uint8_t *pBuf, int32_t iLen)
 int32_t GIFSeekFile(GIFFILE *pFile, int32_t iPosition)
 {
     File *f = static_cast<File *>(pFile->fHandle);
+    gifBusRelease();
     f->seek(iPosition);
     pFile->iPos = f->position();
     return pFile->iPos;
@@ -65,8 +139,11 @@ int32_t GIFSeekFile(GIFFILE *pFile, int32_t iPosition)
 void GIFDraw(GIFDRAW *pDraw)
 {
     uint8_t *s;
-    uint16_t *d, *usPalette, usTemp[320];
+    uint16_t *d, *usPalette, usTemp[DISPLAY_WIDTH];
     int x, y, iWidth;
+    bool lastLine = pDraw->y == pDraw->iHeight - 1;
+    if (lastLine)
+        gifStats.frames++;
 
     iWidth = pDraw->iWidth;
     if (iWidth + pDraw->iX > DISPLAY_WIDTH)
@@ -78,7 +155,9 @@ void GIFDraw(GIFDRAW *pDraw)
     int gifMaxY = DISPLAY_HEIGHT - tickerHeight;
     if (y >= gifMaxY || pDraw->iX >= DISPLAY_WIDTH || iWidth < 1)
     {
-        updateTicker(); // ~25 FPS
+        gifStripSend();
+        gifBusRelease();
+        updateTicker(); // rate limited to its own frame period
         return;
     }
 
@@ -97,6 +176,9 @@ void GIFDraw(GIFDRAW *pDraw)
     {
         uint8_t *pEnd, c, ucTransparent = pDraw->ucTransparent;
         int x, iCount;
+        gifStripSend();
+        gifBusHold();
+        tft.dmaWait(); // pushPixels() must not overlap the strip transfer
         pEnd = s + iWidth;
         x = 0;
         iCount = 0;
@@ -119,10 +201,10 @@ void GIFDraw(GIFDRAW *pDraw)
             }
             if (iCount)
             {
-                tft.startWrite();
                 tft.setAddrWindow(pDraw->iX + x, y, iCount, 1);
                 tft.pushPixels(usTemp, iCount);
-                tft.endWrite();
+                gifStats.bytes += iCount * 2;
+                gifStats.writes++;
                 x += iCount;
                 iCount = 0;
             }
@@ -145,12 +227,16 @@ void GIFDraw(GIFDRAW *pDraw)
     else
     {
         s = pDraw->pPixels;
+        d = gifStripLine(pDraw->iX, y, iWidth);
         for (x = 0; x < iWidth; x++)
-            usTemp[x] = usPalette[*s++];
-        tft.startWrite();
-        tft.setAddrWindow(pDraw->iX, y, iWidth, 1);
-        tft.pushPixels(usTemp, iWidth);
-        tft.endWrite();
+            d[x] = usPalette[*s++];
+        if (++gifStripRows >= gifStripLimit)
+            gifStripSend();
+    }
+    if (lastLine)
+    {
+        gifStripSend();
+        gifBusRelease(); // the rest of loop() may draw between frames
     }
     // // After finishing the last line of the GIF frame:
     // if (pDraw->iY + pDraw->y >= DISPLAY_HEIGHT - 1)
@@ -166,24 +252,128 @@ void GIFDraw(GIFDRAW *pDraw)
     // }
 }
 
-// ==== Play one GIF file ====
-void play_gif(const char *filename)
+// ==== Media player ====
+// The render task calls step() on every pass. A GIF decodes at most one whole frame per call (the
+// decoder cannot stop mid-frame), and only once the previous frame's delay has run out (a deadline,
+// no sleeping), so the task keeps checking for new screen requests between frames. A frame that
+// takes longer than its delay simply plays late; if the schedule falls MEDIA_MAX_SLIP_MS behind it
+// restarts from now instead of racing to catch up. A JPEG is drawn once and held for
+// MEDIA_JPEG_HOLD_MS.
+#define MEDIA_JPEG_HOLD_MS 5000
+#define MEDIA_MAX_SLIP_MS 200
+
+enum : uint8_t
 {
-    Serial.printf("[play_gif] Opening: %s\n", filename);
-    if (gif.open(filename, GIFOpenFile, GIFCloseFile, GIFReadFile, GIFSeekFile, GIFDraw))
+    MEDIA_IDLE,
+    MEDIA_GIF,
+    MEDIA_JPEG
+};
+
+class MediaPlayer
+{
+public:
+    bool begin(const char *filename)
+    {
+        stop();
+        snprintf(_name, sizeof(_name), "%s", filename);
+        size_t n = strlen(_name);
+        bool isGif = n > 4 && !strcasecmp(_name + n - 4, ".gif");
+        _due = millis();
+        if (!isGif)
+        {
+            show_jpeg(_name);
+            _due += MEDIA_JPEG_HOLD_MS;
+            _state = MEDIA_JPEG;
+            return true;
+        }
+        Serial.printf("[MediaPlayer] Opening: %s\n", _name);
+        if (!gif.open(_name, GIFOpenFile, GIFCloseFile, GIFReadFile, GIFSeekFile, GIFDraw))
+        {
+            Serial.printf("[MediaPlayer] ERROR opening %s (%d)\n", _name, gif.getLastError());
+            return false;
+        }
+        gifStats = {};
+        gifStripRows = 0;
+        _started = _due;
+        _lastFrame = false;
+        _state = MEDIA_GIF;
+        return true;
+    }
+
+    // Returns false once nothing is playing
+    bool step()
     {
-        Serial.printf("[play_gif] Playing %s...\n", filename);
-        while (gif.playFrame(true, NULL))
+        if (_state == MEDIA_IDLE)
+            return false;
+        uint32_t now = millis();
+        if ((int32_t)(now - _due) < 0)
+            return true; // current frame is still on screen
+        if (_state == MEDIA_JPEG || _lastFrame)
+        {
+            stop();
+            return false;
+        }
+
+        uint32_t t0 = micros();
+        int delayMs = 0;
+        int rc = gif.playFrame(false, &delayMs);
+        uint32_t took = micros() - t0;
+        _frameUs = _frameUs ? (_frameUs * 3 + took) / 4 : took;
+        if (rc < 0)
         {
-            blinkLED(boreMode, true);
-            blinkLED(sumpMode, false);
+            stop();
+            return false;
         }
-        gif.close();
-        Serial.printf("[play_gif] Done: %s\n", filename);
+        // Deadlines chain from the previous one so decode time does not stretch the animation;
+        // after a long stall restart the chain instead of racing to catch up
+        _due += gifFrameDelays ? delayMs : 0;
+        if ((int32_t)(millis() - _due) > MEDIA_MAX_SLIP_MS)
+            _due = millis();
+        _lastFrame = rc == 0;
+        return true;
     }
-    else
+
+    bool playing() const
+    {
+        return _state != MEDIA_IDLE;
+    }
+
+    void stop()
+    {
+        if (_state == MEDIA_GIF)
+        {
+            gifStripSend();
+            gifBusRelease();
+            gif.close();
+            uint32_t ms = millis() - _started;
+            uint32_t frames = gifStats.frames ? gifStats.frames : 1;
+            Serial.printf("[MediaPlayer] Done: %s, %u frames in %u ms (%.1f FPS), %u bytes/frame, %u windows/frame, %u lines/strip, %u us/frame\n",
+                          _name, (unsigned)gifStats.frames, (unsigned)ms, ms ? gifStats.frames * 1000.0f / ms : 0.0f,
+                          (unsigned)(gifStats.bytes / frames), (unsigned)(gifStats.writes / frames), gifStripLimit, (unsigned)_frameUs);
+        }
+        if (_state != MEDIA_IDLE)
+            panel.invalidate(); // media drew over the status panel
+        _state = MEDIA_IDLE;
+    }
+
+private:
+    uint8_t _state = MEDIA_IDLE;
+    char _name[64];
+    uint32_t _due = 0;     // millis() when the next frame may be drawn
+    uint32_t _started = 0;
+    uint32_t _frameUs = 0; // running average of one frame's decode and output time, for the log
+    bool _lastFrame = false;
+};
+
+MediaPlayer player;
+
+// ==== Play one file to the end (blocking; only the benchmark uses it) ====
+void play_gif(const char *filename)
+{
+    if (player.begin(filename))
     {
-        Serial.printf("[play_gif] ERROR opening %s (%d)\n", filename, gif.getLastError());
+        while (player.step())
+            yield();
     }
 }
 
@@ -264,15 +454,16 @@ void gifJpegInitialize()
     Serial.println("[setup] SD mounted!");
 
     gif.begin(BIG_ENDIAN_PIXELS);
+    gifDma = tft.initDMA();
     TJpgDec.setCallback(tft_output); // ✅ JPEG init
     TJpgDec.setSwapBytes(true);
 
     scanDir(SD, "/");
 
-    Serial.printf("[setup] Total media found: %d\n", mediaFiles.size());
+    Serial.printf("[setup] Total media found: %u\n", (unsigned)mediaFiles.size());
     for (size_t i = 0; i < mediaFiles.size(); i++)
     {
-        Serial.printf("[setup] [%d] %s\n", i, mediaFiles[i].c_str());
+        Serial.printf("[setup] [%u] %s\n", (unsigned)i, mediaFiles[i].c_str());
     }
 
     if (mediaFiles.empty())
@@ -283,3 +474,27 @@ void gifJpegInitialize()
         tft.print("No media found!");
     }
 }
+
+// ==== GIF output benchmark (-DGIF_BENCH) ====
+// Plays every GIF on the card as fast as it decodes, once line by line and once in strips;
+// the player prints FPS, bytes and address windows per frame for each run.
+void gifBenchmark()
+{
+    Serial.printf("[gifBenchmark] DMA %s, %u lines/strip\n", gifDma ? "on" : "off", GIF_STRIP_LINES);
+    gifFrameDelays = false;
+    for (size_t i = 0; i < mediaFiles.size(); i++)
+    {
+        const String &fname = mediaFiles[i];
+        if (!fname.endsWith(".gif") && !fname.endsWith(".GIF"))
+            continue;
+        const uint8_t runs[] = {1, GIF_STRIP_LINES};
+        for (uint8_t lines : runs)
+        {
+            gifStripLimit = lines;
+            play_gif(fname.c_str());
+        }
+    }
+    gifStripLimit = GIF_STRIP_LINES;
+    gifFrameDelays = true;
+    panel.invalidate();
+}
@@ -0,0 +1,26 @@
+// boardPins.h — ESP32 pin map for the WLC board (shared by firmware and host simulator)
+#pragma once
+
+#define SD_CS 22
+#define DISPLAY_WIDTH 320
+#define DISPLAY_HEIGHT 240
+// --------------------- Pin Definitions (ESP32) -------------------------
+#define FLOAT_BORE_OHT_PIN 18 // 0=LOW, 1=Full
+#define FLOAT_SUMP_UGT_PIN 12 // 0=empty, 1=full
+#define FLOAT_SUMP_OHT_PIN 13 // 0=LOW, 1=Full
+
+#define BORE_MOTOR_RELAY_PIN 4
+#define SUMP_MOTOR_RELAY_PIN 19
+#define BORE_MOTOR_STATUS_LED 14
+#define SUMP_MOTOR_STATUS_LED 2
+
+#define KEY_SET 26
+#define KEY_UP 25
+#define KEY_DOWN 27
+#define SW_AUTO 33
+#define SW_MANUAL 32
+
+#define PZEM_RX_PIN 16
+#define PZEM_TX_PIN 17
+#define I2C_SDA 21
+#define I2C_SCL 22
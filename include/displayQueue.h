@@ -0,0 +1,48 @@
+// displayQueue.h — Lock-free single-producer / single-consumer queue
+// loop() pushes display commands and the render task pops them. Head and tail each have a single
+// writer, so push and pop are a couple of loads and one release store and neither side ever waits
+// for the other. A full queue refuses the push; the producer keeps the item and tries again.
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+
+template <class T, size_t N>
+class SpscQueue
+{
+    static_assert(N && (N & (N - 1)) == 0, "SpscQueue size must be a power of two");
+
+public:
+    // Producer side
+    bool push(const T &item)
+    {
+        uint32_t tail = _tail.load(std::memory_order_relaxed);
+        if (tail - _head.load(std::memory_order_acquire) == N)
+            return false;
+        _items[tail % N] = item;
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side
+    bool pop(T &item)
+    {
+        uint32_t head = _head.load(std::memory_order_relaxed);
+        if (head == _tail.load(std::memory_order_acquire))
+            return false;
+        item = _items[head % N];
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool empty() const
+    {
+        return _head.load(std::memory_order_acquire) == _tail.load(std::memory_order_acquire);
+    }
+
+private:
+    T _items[N];
+    std::atomic<uint32_t> _head{0}; // written by the consumer only
+    std::atomic<uint32_t> _tail{0}; // written by the producer only
+};
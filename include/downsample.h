@@ -0,0 +1,74 @@
+// downsample.h — Streaming min/max/mean buckets for chart queries
+// [from, to] is cut into at most `points` equal buckets; samples arrive in time order and each
+// bucket is handed to the sink as soon as a later sample closes it, so memory is one bucket no
+// matter how many samples go through. Keeping min and max per bucket means a short current spike
+// or voltage dip still shows on a 30 day chart. Buckets without samples are skipped.
+#pragma once
+
+#include <stdint.h>
+
+struct Bucket
+{
+    uint32_t time; // start of the bucket
+    int32_t min;
+    int32_t max;
+    int64_t sum;
+    uint32_t count;
+};
+
+template <class Sink>
+class MinMaxDownsampler
+{
+public:
+    explicit MinMaxDownsampler(Sink sink) : _sink(sink) {}
+
+    void begin(uint32_t from, uint32_t to, uint32_t points)
+    {
+        uint32_t span = to - from + 1;
+        _from = from;
+        _width = points ? (span + points - 1) / points : span;
+        if (!_width)
+            _width = 1;
+        _open = false;
+    }
+
+    uint32_t width() const
+    {
+        return _width;
+    }
+
+    void add(uint32_t t, int32_t value)
+    {
+        if (t < _from)
+            return;
+        uint32_t start = _from + (t - _from) / _width * _width;
+        if (_open && start != _bucket.time)
+            finish();
+        if (!_open)
+        {
+            _bucket = {start, value, value, 0, 0};
+            _open = true;
+        }
+        if (value < _bucket.min)
+            _bucket.min = value;
+        if (value > _bucket.max)
+            _bucket.max = value;
+        _bucket.sum += value;
+        _bucket.count++;
+    }
+
+    // Emit the bucket still open (end of the query)
+    void finish()
+    {
+        if (_open)
+            _sink(_bucket);
+        _open = false;
+    }
+
+private:
+    Sink _sink;
+    uint32_t _from = 0;
+    uint32_t _width = 1;
+    bool _open = false;
+    Bucket _bucket;
+};
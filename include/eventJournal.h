@@ -0,0 +1,219 @@
+// eventJournal.h — Append-only event journal on raw NOR flash
+// Fixed 32 byte records with a sequence number and CRC-32 are programmed into erased (0xFF) slots
+// and never rewritten, so a brownout can at worst leave one torn slot, which fails its CRC and is
+// skipped. Sectors are used as a ring: when one fills, the next (oldest) is erased and opened with a
+// higher sector sequence, which spreads erases evenly over the partition. Whoever appends is told
+// when a sector was opened (checkpointDue) so it can write a state snapshot there; recovery then
+// only has to replay the newest two sectors.
+// Flash supplies read/write(offset, buf, len) and erase(offset, len) on 4 KB sectors.
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#define JOURNAL_SECTOR_SIZE 4096
+#define JOURNAL_MAGIC 0x4C4E524A // "JRNL"
+
+enum JournalType : uint8_t
+{
+    EV_BOOT = 1,     // a = reset reason
+    EV_START,        // a = powerFailed before the start
+    EV_STOP,         // a = StopReason (runLog.h), b = run time ms
+    EV_FAULT,        // a = error code, b = voltage 0.1 V, c = current mA
+    EV_CALIBRATION,  // a = voltage 0.1 V, b = current mA, c = PF 0.01
+    EV_SETTINGS,     // a = CRC-32 of the Settings block, b = onTime, c = offTime
+    EV_STATE,        // checkpoint per motor: a = running, b = ms since it stopped (-1 never), c = error
+    EV_SYSTEM,       // checkpoint: a = powerFailed
+    EV_HEARTBEAT     // bounds how long ago the power went
+};
+
+struct JournalRecord
+{
+    uint32_t seq;    // set by append()
+    uint32_t time;   // s, wall clock or the telemetry timeline
+    uint32_t uptime; // io.now() ms
+    uint8_t type;
+    uint8_t motor;
+    uint16_t reserved;
+    int32_t a, b, c;
+    uint32_t crc; // CRC-32 of everything above
+};
+static_assert(sizeof(JournalRecord) == 32, "journal slots are 32 bytes");
+
+inline uint32_t journalCrc32(const void *data, size_t len, uint32_t crc = 0)
+{
+    const uint8_t *p = (const uint8_t *)data;
+    crc = ~crc;
+    while (len--)
+    {
+        crc ^= *p++;
+        for (uint8_t k = 0; k < 8; k++)
+            crc = (crc >> 1) ^ (0xEDB88320 & (0U - (crc & 1)));
+    }
+    return ~crc;
+}
+
+template <class Flash>
+class EventJournal
+{
+    struct SectorHeader
+    {
+        uint32_t magic;
+        uint32_t sectorSeq; // increases by one per opened sector
+        uint32_t firstSeq;  // record sequence of the first slot
+        uint32_t crc;
+    };
+
+    static const uint16_t SLOTS = (JOURNAL_SECTOR_SIZE - sizeof(SectorHeader)) / sizeof(JournalRecord);
+
+public:
+    EventJournal(Flash &flash, uint32_t sectors) : _flash(flash), _sectors(sectors) {}
+
+    // Find the newest sector and the first free slot in it; cost: one header per sector + one sector
+    bool begin()
+    {
+        _valid = false;
+        uint32_t best = 0;
+        for (uint32_t s = 0; s < _sectors; s++)
+        {
+            SectorHeader h;
+            if (!readHeader(s, h))
+                continue;
+            if (!_valid || (int32_t)(h.sectorSeq - best) > 0)
+            {
+                _valid = true;
+                best = h.sectorSeq;
+                _sector = s;
+            }
+        }
+        if (!_valid)
+            return openSector(0, 1, 1);
+
+        SectorHeader h;
+        readHeader(_sector, h);
+        _sectorSeq = h.sectorSeq;
+        _nextSeq = h.firstSeq;
+        _slot = 0;
+        for (uint16_t i = 0; i < SLOTS; i++)
+        {
+            JournalRecord r;
+            _flash.read(slotOffset(_sector, i), &r, sizeof(r));
+            if (isErased(r))
+                continue;
+            _slot = i + 1; // never reuse a slot after a torn one
+            if (recordValid(r))
+                _nextSeq = r.seq + 1;
+        }
+        return true;
+    }
+
+    // Stamp seq and CRC, program the next free slot; opens (erases) the next sector when full
+    bool append(JournalRecord r)
+    {
+        if (!_valid)
+            return false;
+        if (_slot >= SLOTS && !openSector((_sector + 1) % _sectors, _sectorSeq + 1, _nextSeq))
+            return false;
+        r.seq = _nextSeq++;
+        r.reserved = 0;
+        r.crc = journalCrc32(&r, offsetof(JournalRecord, crc));
+        return _flash.write(slotOffset(_sector, _slot++), &r, sizeof(r));
+    }
+
+    // True once after a sector was opened: time to append a state checkpoint
+    bool checkpointDue()
+    {
+        bool due = _checkpointDue;
+        _checkpointDue = false;
+        return due;
+    }
+
+    // Every valid record of the previous and the newest sector, oldest first
+    template <class F>
+    void replay(F fn) const
+    {
+        if (!_valid)
+            return;
+        SectorHeader h;
+        uint32_t prev = (_sector + _sectors - 1) % _sectors;
+        if (_sectors > 1 && readHeader(prev, h) && h.sectorSeq == _sectorSeq - 1)
+            replaySector(prev, fn);
+        replaySector(_sector, fn);
+    }
+
+    uint32_t nextSeq() const
+    {
+        return _nextSeq;
+    }
+
+    uint32_t sectors() const
+    {
+        return _sectors;
+    }
+
+private:
+    Flash &_flash;
+    uint32_t _sectors;
+    bool _valid = false;
+    bool _checkpointDue = false;
+    uint32_t _sector = 0;
+    uint32_t _sectorSeq = 0;
+    uint32_t _nextSeq = 1;
+    uint16_t _slot = 0;
+
+    static uint32_t slotOffset(uint32_t sector, uint16_t slot)
+    {
+        return sector * JOURNAL_SECTOR_SIZE + sizeof(SectorHeader) + slot * sizeof(JournalRecord);
+    }
+
+    static bool isErased(const JournalRecord &r)
+    {
+        const uint8_t *p = (const uint8_t *)&r;
+        for (size_t i = 0; i < sizeof(r); i++)
+            if (p[i] != 0xFF)
+                return false;
+        return true;
+    }
+
+    static bool recordValid(const JournalRecord &r)
+    {
+        return r.crc == journalCrc32(&r, offsetof(JournalRecord, crc));
+    }
+
+    bool readHeader(uint32_t sector, SectorHeader &h) const
+    {
+        if (!_flash.read(sector * JOURNAL_SECTOR_SIZE, &h, sizeof(h)))
+            return false;
+        return h.magic == JOURNAL_MAGIC && h.crc == journalCrc32(&h, offsetof(SectorHeader, crc));
+    }
+
+    bool openSector(uint32_t sector, uint32_t sectorSeq, uint32_t firstSeq)
+    {
+        if (!_flash.erase(sector * JOURNAL_SECTOR_SIZE, JOURNAL_SECTOR_SIZE))
+            return false;
+        SectorHeader h = {JOURNAL_MAGIC, sectorSeq, firstSeq, 0};
+        h.crc = journalCrc32(&h, offsetof(SectorHeader, crc));
+        if (!_flash.write(sector * JOURNAL_SECTOR_SIZE, &h, sizeof(h)))
+            return false;
+        _valid = true;
+        _sector = sector;
+        _sectorSeq = sectorSeq;
+        _nextSeq = firstSeq;
+        _slot = 0;
+        _checkpointDue = true;
+        return true;
+    }
+
+    template <class F>
+    void replaySector(uint32_t sector, F &fn) const
+    {
+        for (uint16_t i = 0; i < SLOTS; i++)
+        {
+            JournalRecord r;
+            _flash.read(slotOffset(sector, i), &r, sizeof(r));
+            if (!isErased(r) && recordValid(r))
+                fn(r);
+        }
+    }
+};
@@ -0,0 +1,60 @@
+// eventStream.h — Bounded per-client send queue for Server-Sent Events
+// Records go in whole or not at all: a client whose socket cannot keep up fills its queue, the
+// next push fails and the caller drops the client instead of blocking the loop on it or sending
+// it half a record. The writer side drains with contiguous() / consume() so a socket write never
+// needs a copy.
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+template <size_t N>
+class EventQueue
+{
+public:
+    // false (and nothing queued) if the record does not fit
+    bool push(const char *data, size_t len)
+    {
+        if (len > N - _used)
+            return false;
+        size_t tail = (_head + _used) % N;
+        size_t first = len < N - tail ? len : N - tail;
+        memcpy(_buf + tail, data, first);
+        memcpy(_buf, data + first, len - first);
+        _used += len;
+        return true;
+    }
+
+    // Oldest queued bytes that are contiguous in the buffer
+    const char *contiguous(size_t &len) const
+    {
+        len = _used < N - _head ? _used : N - _head;
+        return _buf + _head;
+    }
+
+    void consume(size_t len)
+    {
+        if (len > _used)
+            len = _used;
+        _head = (_head + len) % N;
+        _used -= len;
+        if (!_used)
+            _head = 0;
+    }
+
+    void clear()
+    {
+        _head = _used = 0;
+    }
+
+    size_t used() const
+    {
+        return _used;
+    }
+
+private:
+    char _buf[N];
+    size_t _head = 0;
+    size_t _used = 0;
+};
@@ -0,0 +1,112 @@
+// floatInputs.h — Debounced float-switch levels, sampled from a periodic timer interrupt
+// Each float has an integrator that counts up while the raw pin reads HIGH and down while it reads
+// LOW (clamped to 0..FLOAT_INTEGRATOR_MAX). The stable level only flips at the far thresholds, so
+// slosh that toggles a float for a few hundred ms never reaches the control logic. Stable levels
+// live in one word indexed by GPIO number: consumers read memory, never the pins. That word is one
+// GPIO_IN_REG snapshot, so floats must sit on GPIO 0-31 (floatPinsInWord() checks at compile time).
+// Build with -D FLOAT_INTEGRATOR_MAX=1 -D FLOAT_RISE_AT=1 -D FLOAT_FALL_AT=0 for raw pass-through.
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+
+#ifndef IRAM_ATTR
+#define IRAM_ATTR
+#endif
+
+#define FLOAT_SAMPLE_MS 10 // timer period
+#ifndef FLOAT_INTEGRATOR_MAX
+#define FLOAT_INTEGRATOR_MAX 150 // 1.5 s of samples
+#define FLOAT_RISE_AT 120        // stable HIGH once the integrator reaches this...
+#define FLOAT_FALL_AT 30         // ...and LOW again only when it drops to this
+#endif
+
+// True if every pin fits the 32-bit GPIO_IN_REG word the levels are kept in
+constexpr bool floatPinsInWord(const uint8_t *pins, size_t n)
+{
+    return n == 0 || (pins[0] < 32 && floatPinsInWord(pins + 1, n - 1));
+}
+
+template <uint8_t N>
+class FloatInputs
+{
+public:
+    FloatInputs(const uint8_t (&pins)[N])
+    {
+        for (uint8_t i = 0; i < N; i++)
+        {
+            _pin[i] = pins[i];
+            _integrator[i] = 0;
+            _changedAt[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    // Take the raw pins as the stable state (boot), so nothing waits a full integration period
+    void prime(uint32_t gpioIn, uint32_t now)
+    {
+        uint32_t levels = 0;
+        for (uint8_t i = 0; i < N; i++)
+        {
+            bool high = (gpioIn >> _pin[i]) & 1;
+            _integrator[i] = high ? FLOAT_INTEGRATOR_MAX : 0;
+            _changedAt[i].store(now, std::memory_order_relaxed);
+            if (high)
+                levels |= 1UL << _pin[i];
+        }
+        _levels.store(levels, std::memory_order_release);
+    }
+
+    // Timer ISR: gpioIn is the GPIO input register (bit n = GPIOn)
+    void IRAM_ATTR sample(uint32_t gpioIn, uint32_t now)
+    {
+        uint32_t levels = _levels.load(std::memory_order_relaxed);
+        uint32_t next = levels;
+        for (uint8_t i = 0; i < N; i++)
+        {
+            uint32_t bit = 1UL << _pin[i];
+            if (gpioIn & bit)
+            {
+                if (_integrator[i] < FLOAT_INTEGRATOR_MAX)
+                    _integrator[i]++;
+            }
+            else if (_integrator[i] > 0)
+                _integrator[i]--;
+
+            if (!(next & bit) && _integrator[i] >= FLOAT_RISE_AT)
+                next |= bit;
+            else if ((next & bit) && _integrator[i] <= FLOAT_FALL_AT)
+                next &= ~bit;
+            if ((next ^ levels) & bit)
+                _changedAt[i].store(now, std::memory_order_relaxed);
+        }
+        if (next != levels)
+            _levels.store(next, std::memory_order_release);
+    }
+
+    // Stable levels of every float, bit n = GPIOn
+    uint32_t levels() const
+    {
+        return _levels.load(std::memory_order_acquire);
+    }
+
+    int level(uint8_t pin) const
+    {
+        return (levels() >> pin) & 1;
+    }
+
+    // Clock value of the last stable change of pin (0 if it is not a float input)
+    uint32_t changedAt(uint8_t pin) const
+    {
+        for (uint8_t i = 0; i < N; i++)
+            if (_pin[i] == pin)
+                return _changedAt[i].load(std::memory_order_relaxed);
+        return 0;
+    }
+
+private:
+    uint8_t _pin[N];
+    uint8_t _integrator[N];
+    std::atomic<uint32_t> _changedAt[N];
+    std::atomic<uint32_t> _levels{0};
+};
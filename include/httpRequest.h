@@ -0,0 +1,254 @@
+// httpRequest.h — Incremental HTTP/1.x request parser over one fixed buffer
+// Bytes are fed as the socket delivers them; once the blank line arrives the request line and
+// headers are split in place (NUL terminated, offsets recorded), so looking up a header or form
+// argument later costs a scan of the buffer and no String or heap allocation ever happens. Bodies
+// (forms) are only accepted with a Content-Length and must fit the same buffer.
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+template <size_t BUF, uint8_t MAX_HEADERS>
+class HttpRequest
+{
+public:
+    enum State : uint8_t
+    {
+        READING,   // need more bytes
+        COMPLETE,  // request line, headers and body are in
+        BAD,       // malformed: answer 400
+        TOO_LARGE  // headers or body do not fit BUF: answer 413
+    };
+
+    void reset()
+    {
+        _len = 0;
+        _scan = 0;
+        _bodyStart = 0;
+        _bodyLen = 0;
+        _headers = 0;
+        _state = READING;
+    }
+
+    State feed(const char *data, size_t len)
+    {
+        if (_state != READING)
+            return _state;
+        if (len > BUF - 1 - _len)
+            return _state = TOO_LARGE;
+        memcpy(_buf + _len, data, len);
+        _len += len;
+        _buf[_len] = '\0';
+
+        if (!_bodyStart)
+        {
+            size_t end = findHeaderEnd();
+            if (!end)
+                return _state;
+            _bodyStart = end;
+            if (!parseHead(end))
+                return _state = BAD;
+            const char *cl = header("Content-Length");
+            _bodyLen = cl ? strtoul(cl, nullptr, 10) : 0;
+            if (_bodyLen > BUF - 1 - _bodyStart)
+                return _state = TOO_LARGE;
+        }
+        if (_len - _bodyStart >= _bodyLen)
+        {
+            _buf[_bodyStart + _bodyLen] = '\0'; // ignore anything pipelined after the body
+            _state = COMPLETE;
+        }
+        return _state;
+    }
+
+    State state() const
+    {
+        return _state;
+    }
+
+    // Valid once COMPLETE
+    const char *method() const
+    {
+        return _buf;
+    }
+
+    const char *path() const
+    {
+        return _buf + _path;
+    }
+
+    const char *body() const
+    {
+        return _buf + _bodyStart;
+    }
+
+    // Case-insensitive; nullptr if absent
+    const char *header(const char *name) const
+    {
+        for (uint8_t i = 0; i < _headers; i++)
+            if (!strcasecmp(_buf + _header[i].name, name))
+                return _buf + _header[i].value;
+        return nullptr;
+    }
+
+    // Query string first, then an urlencoded form body
+    bool hasArg(const char *name) const
+    {
+        return findArg(_buf + _query, name) || (isForm() && findArg(body(), name));
+    }
+
+    // URL-decoded value into out (truncated to cap - 1); false if the argument is absent
+    bool arg(const char *name, char *out, size_t cap) const
+    {
+        const char *v = findArg(_buf + _query, name);
+        if (!v && isForm())
+            v = findArg(body(), name);
+        if (!v)
+        {
+            if (cap)
+                out[0] = '\0';
+            return false;
+        }
+        decode(v, out, cap);
+        return true;
+    }
+
+private:
+    struct HeaderRef
+    {
+        uint16_t name;
+        uint16_t value;
+    };
+
+    char _buf[BUF];
+    size_t _len = 0;
+    size_t _scan = 0;      // header end search resumes here
+    size_t _bodyStart = 0; // 0 until the blank line was seen
+    size_t _bodyLen = 0;
+    uint16_t _path = 0;
+    uint16_t _query = 0; // points at an empty string when there is none
+    uint8_t _headers = 0;
+    State _state = READING;
+    HeaderRef _header[MAX_HEADERS];
+
+    // Offset just past the first empty line (CRLF or bare LF), 0 if not there yet
+    size_t findHeaderEnd()
+    {
+        for (size_t i = _scan; i < _len; i++)
+        {
+            if (_buf[i] != '\n')
+                continue;
+            if (i + 1 < _len && _buf[i + 1] == '\n')
+                return i + 2;
+            if (i + 2 < _len && _buf[i + 1] == '\r' && _buf[i + 2] == '\n')
+                return i + 3;
+        }
+        _scan = _len > 2 ? _len - 2 : 0;
+        return 0;
+    }
+
+    // Next line in [from, end): terminates it in place, returns the offset after it
+    size_t cutLine(size_t from, size_t end)
+    {
+        size_t i = from;
+        while (i < end && _buf[i] != '\n')
+            i++;
+        if (i > from && _buf[i - 1] == '\r')
+            _buf[i - 1] = '\0';
+        if (i < end)
+            _buf[i++] = '\0';
+        return i;
+    }
+
+    bool parseHead(size_t end)
+    {
+        size_t next = cutLine(0, end);
+        // METHOD SP target SP version
+        char *sp = strchr(_buf, ' ');
+        if (!sp)
+            return false;
+        *sp = '\0';
+        _path = sp + 1 - _buf;
+        char *sp2 = strchr(_buf + _path, ' ');
+        if (!sp2 || _buf[_path] != '/')
+            return false;
+        *sp2 = '\0';
+        char *q = strchr(_buf + _path, '?');
+        if (q)
+        {
+            *q = '\0';
+            _query = q + 1 - _buf;
+        }
+        else
+            _query = sp2 - _buf; // the NUL just written
+
+        while (next < end)
+        {
+            size_t line = next;
+            next = cutLine(line, end);
+            if (!_buf[line])
+                break; // the blank line
+            char *colon = strchr(_buf + line, ':');
+            if (!colon)
+                return false;
+            if (_headers >= MAX_HEADERS)
+                continue; // keep going, the extra ones are just not searchable
+            *colon = '\0';
+            char *value = colon + 1;
+            while (*value == ' ' || *value == '\t')
+                value++;
+            _header[_headers++] = {(uint16_t)line, (uint16_t)(value - _buf)};
+        }
+        return true;
+    }
+
+    bool isForm() const
+    {
+        const char *type = header("Content-Type");
+        return _bodyLen && type && !strncasecmp(type, "application/x-www-form-urlencoded", 33);
+    }
+
+    // Start of the (still encoded) value of name in an a=1&b=2 list, or "" for a bare name
+    static const char *findArg(const char *list, const char *name)
+    {
+        size_t n = strlen(name);
+        const char *p = list;
+        while (*p)
+        {
+            if (!strncmp(p, name, n) && (p[n] == '=' || p[n] == '&' || !p[n]))
+                return p[n] == '=' ? p + n + 1 : p + n;
+            p = strchr(p, '&');
+            if (!p)
+                break;
+            p++;
+        }
+        return nullptr;
+    }
+
+    static int hexValue(char c)
+    {
+        return c >= '0' && c <= '9' ? c - '0' : c >= 'a' && c <= 'f' ? c - 'a' + 10 : c >= 'A' && c <= 'F' ? c - 'A' + 10 : -1;
+    }
+
+    static void decode(const char *v, char *out, size_t cap)
+    {
+        size_t n = 0;
+        while (*v && *v != '&' && n + 1 < cap)
+        {
+            char c = *v++;
+            if (c == '+')
+                c = ' ';
+            else if (c == '%' && hexValue(v[0]) >= 0 && hexValue(v[1]) >= 0)
+            {
+                c = (char)(hexValue(v[0]) * 16 + hexValue(v[1]));
+                v += 2;
+            }
+            out[n++] = c;
+        }
+        if (cap)
+            out[n] = '\0';
+    }
+};
@@ -0,0 +1,403 @@
+// httpServer.cpp — Web server polled from its own task instead of loop()
+// Included by main.cpp in place of WebServer. Keeps the WebServer calls the handlers already use
+// (on, arg, hasArg, header, send, sendHeader, setContentLength, sendContent, client), but:
+//  - poll() runs in httpTask and services a small pool of connections, feeding whatever bytes
+//    arrived into a fixed-buffer parser (httpRequest.h), so one slow client does not hold the rest;
+//  - read-only routes run right there, against the published ControllerView, while display and
+//    control work carry on in loop();
+//  - routes that change controller state are registered onLoop (or a handler calls deferToLoop()):
+//    the connection is parked and loop() runs the handler from serviceLoop() (while it holds the
+//    SPI bus), so control state and the SD card keep a single user. A parked request loop() does
+//    not reach within HTTP_LOOP_WAIT_MS gets a 503 and its abort handler, if it gave one.
+// Every response closes its connection.
+
+#include <httpRequest.h>
+#include <atomic>
+
+#define HTTP_CONNECTIONS 4
+#define HTTP_REQUEST_BYTES 2048 // request line + headers + form body
+#define HTTP_MAX_HEADERS 16
+#define HTTP_RESPONSE_HEADER_BYTES 384 // sendHeader() lines of one response
+#define HTTP_ROUTES 16
+#define HTTP_IDLE_MS 5000     // a request not complete by then is dropped
+#define HTTP_LOOP_WAIT_MS 30000 // parked request loop() never got to (calibration takes ~25 s)
+#define HTTP_ARG_MAX 128
+
+class HttpServer
+{
+public:
+    typedef void (*Handler)();
+
+    explicit HttpServer(uint16_t port) : _listener(port) {}
+
+    void on(const char *path, Handler handler, bool onLoop = false)
+    {
+        on(path, HTTP_ANY, handler, onLoop);
+    }
+
+    void on(const char *path, HTTPMethod method, Handler handler, bool onLoop = false)
+    {
+        if (_routes < HTTP_ROUTES)
+            _route[_routes++] = {path, method, handler, onLoop};
+    }
+
+    // Requests no route matched (static files); runs in httpTask
+    void onNotFound(Handler handler)
+    {
+        _notFound = handler;
+    }
+
+    // Every header is kept by the parser; here for WebServer compatibility
+    void collectHeaders(const char **, size_t) {}
+
+    void begin()
+    {
+        _listener.begin();
+        _listener.setNoDelay(true);
+    }
+
+    // httpTask: accept, read and dispatch; never waits on a socket
+    void poll()
+    {
+        _task = xTaskGetCurrentTaskHandle();
+        uint32_t now = millis();
+        accept(now);
+        for (uint8_t i = 0; i < HTTP_CONNECTIONS; i++)
+        {
+            Connection &c = _conn[i];
+            uint8_t state = c.state.load(std::memory_order_acquire);
+            if (state == CONN_READING)
+                read(c, now);
+            else if (state == CONN_PARKED && now - c.lastActivity >= HTTP_LOOP_WAIT_MS)
+            {
+                uint8_t expected = CONN_PARKED;
+                if (c.state.compare_exchange_strong(expected, CONN_ON_TASK))
+                {
+                    _taskCurrent = &c;
+                    send(503, "text/plain", "Controller busy, try again");
+                    Handler aborted = c.aborted;
+                    release(c);
+                    if (aborted)
+                        aborted(); // the deferred handler will never run: let it give back what it holds
+                }
+            }
+        }
+    }
+
+    // loop(): run one parked request, if any. A handler that calls deferToLoop() again is parked
+    // again and continues on a later pass (long queries done in slices).
+    void serviceLoop()
+    {
+        for (uint8_t n = 0; n < HTTP_CONNECTIONS; n++)
+        {
+            uint8_t i = (_loopNext + n) % HTTP_CONNECTIONS; // round robin: a sliced query cannot starve the rest
+            Connection &c = _conn[i];
+            uint8_t expected = CONN_PARKED;
+            if (!c.state.compare_exchange_strong(expected, CONN_ON_LOOP))
+                continue;
+            _loopNext = i + 1;
+            _loopCurrent = &c;
+            Handler handler = c.deferred;
+            c.deferred = nullptr;
+            handler();
+            _loopCurrent = nullptr;
+            if (c.deferred)
+            {
+                c.lastActivity = millis();
+                c.state.store(CONN_PARKED, std::memory_order_release);
+            }
+            else
+                release(c);
+            return;
+        }
+    }
+
+    // ---- request, valid inside a handler ----
+    HTTPMethod method()
+    {
+        return current().method;
+    }
+
+    const char *uri()
+    {
+        return current().request.path();
+    }
+
+    bool hasArg(const char *name)
+    {
+        return current().request.hasArg(name);
+    }
+
+    String arg(const char *name)
+    {
+        char value[HTTP_ARG_MAX];
+        current().request.arg(name, value, sizeof(value));
+        return String(value);
+    }
+
+    // Raw request body (JSON posts); "" when there is none
+    const char *body()
+    {
+        return current().request.body();
+    }
+
+    String header(const char *name)
+    {
+        const char *value = current().request.header(name);
+        return String(value ? value : "");
+    }
+
+    WiFiClient &client()
+    {
+        return current().client;
+    }
+
+    // Answer this request from loop() with handler (from httpTask), or continue it there later.
+    // aborted runs in httpTask instead if the request times out while parked.
+    void deferToLoop(Handler handler, Handler aborted = nullptr)
+    {
+        Connection &c = current();
+        c.deferred = handler;
+        c.aborted = aborted;
+    }
+
+    // ---- response ----
+    void sendHeader(const String &name, const String &value, bool = false)
+    {
+        Connection &c = current();
+        int n = snprintf(c.headers + c.headersLen, sizeof(c.headers) - c.headersLen, "%s: %s\r\n", name.c_str(), value.c_str());
+        if (n > 0 && c.headersLen + n < sizeof(c.headers))
+            c.headersLen += n;
+    }
+
+    void setContentLength(size_t len)
+    {
+        current().contentLength = len;
+    }
+
+    void send(int code, const char *type = nullptr, const String &body = String())
+    {
+        send(code, type, body.c_str(), body.length());
+    }
+
+    void send(int code, const char *type, const char *body)
+    {
+        send(code, type, body, strlen(body));
+    }
+
+    void sendContent(const String &data)
+    {
+        sendContent(data.c_str(), data.length());
+    }
+
+    void sendContent(const char *data, size_t len)
+    {
+        WiFiClient &client = current().client;
+        while (len)
+        {
+            size_t sent = client.write((const uint8_t *)data, len); // blocks up to the socket timeout
+            if (!sent)
+                break;
+            data += sent;
+            len -= sent;
+        }
+    }
+
+private:
+    enum : uint8_t
+    {
+        CONN_FREE,
+        CONN_READING,
+        CONN_ON_TASK, // handler running in httpTask
+        CONN_PARKED,  // waiting for loop()
+        CONN_ON_LOOP  // handler running in loop()
+    };
+
+    struct Route
+    {
+        const char *path;
+        HTTPMethod method;
+        Handler handler;
+        bool onLoop;
+    };
+
+    struct Connection
+    {
+        std::atomic<uint8_t> state{CONN_FREE};
+        WiFiClient client;
+        HttpRequest<HTTP_REQUEST_BYTES, HTTP_MAX_HEADERS> request;
+        HTTPMethod method = HTTP_GET;
+        Handler deferred = nullptr; // to run in loop()
+        Handler aborted = nullptr;  // to run if it never does
+        uint32_t lastActivity = 0;
+        char headers[HTTP_RESPONSE_HEADER_BYTES];
+        size_t headersLen = 0;
+        size_t contentLength = CONTENT_LENGTH_NOT_SET;
+        bool headersSent = false;
+    };
+
+    WiFiServer _listener;
+    Route _route[HTTP_ROUTES];
+    uint8_t _routes = 0;
+    Handler _notFound = nullptr;
+    Connection _conn[HTTP_CONNECTIONS];
+    TaskHandle_t _task = nullptr;
+    Connection *_taskCurrent = nullptr;
+    Connection *_loopCurrent = nullptr;
+    uint8_t _loopNext = 0; // loop() only
+
+    // Handlers run on either side; each side has its own current connection
+    Connection &current()
+    {
+        return *(xTaskGetCurrentTaskHandle() == _task ? _taskCurrent : _loopCurrent);
+    }
+
+    void accept(uint32_t now)
+    {
+        WiFiClient client = _listener.accept();
+        if (!client)
+            return;
+        for (uint8_t i = 0; i < HTTP_CONNECTIONS; i++)
+        {
+            Connection &c = _conn[i];
+            if (c.state.load(std::memory_order_acquire) != CONN_FREE)
+                continue;
+            c.client = client;
+            c.client.setNoDelay(true);
+            c.request.reset();
+            c.lastActivity = now;
+            c.state.store(CONN_READING, std::memory_order_release);
+            return;
+        }
+        client.write("HTTP/1.1 503 Service Unavailable\r\nConnection: close\r\nContent-Length: 0\r\n\r\n");
+        client.stop();
+    }
+
+    void read(Connection &c, uint32_t now)
+    {
+        if (!c.client.connected())
+        {
+            c.client.stop();
+            c.state.store(CONN_FREE, std::memory_order_release);
+            return;
+        }
+        int avail = c.client.available();
+        if (avail <= 0)
+        {
+            if (now - c.lastActivity >= HTTP_IDLE_MS)
+            {
+                c.client.stop();
+                c.state.store(CONN_FREE, std::memory_order_release);
+            }
+            return;
+        }
+        c.lastActivity = now;
+        char chunk[256];
+        int n = c.client.read((uint8_t *)chunk, avail < (int)sizeof(chunk) ? avail : sizeof(chunk));
+        if (n <= 0)
+            return;
+
+        uint8_t parsed = c.request.feed(chunk, n);
+        if (parsed == c.request.READING)
+            return;
+        startResponse(c);
+        c.state.store(CONN_ON_TASK, std::memory_order_relaxed);
+        _taskCurrent = &c;
+        if (parsed == c.request.BAD)
+            send(400, "text/plain", "Bad request");
+        else if (parsed == c.request.TOO_LARGE)
+            send(413, "text/plain", "Request too large");
+        else if (dispatch(c))
+            return; // parked for loop()
+        release(c);
+    }
+
+    // Runs the handler here, or parks the connection; true if parked
+    bool dispatch(Connection &c)
+    {
+        c.method = parseMethod(c.request.method());
+        const Route *match = nullptr;
+        for (uint8_t r = 0; r < _routes && !match; r++)
+            if (!strcmp(_route[r].path, c.request.path()) && (_route[r].method == HTTP_ANY || _route[r].method == c.method))
+                match = &_route[r];
+
+        if (match && match->onLoop)
+            c.deferred = match->handler;
+        else if (match)
+            match->handler();
+        else if (_notFound)
+            _notFound();
+        else
+            send(404, "text/plain", String("Not found: ") + c.request.path());
+
+        if (!c.deferred)
+            return false;
+        c.lastActivity = millis();
+        c.state.store(CONN_PARKED, std::memory_order_release);
+        return true;
+    }
+
+    void startResponse(Connection &c)
+    {
+        c.headersLen = 0;
+        c.contentLength = CONTENT_LENGTH_NOT_SET;
+        c.headersSent = false;
+        c.deferred = nullptr;
+        c.aborted = nullptr;
+    }
+
+    void release(Connection &c)
+    {
+        c.aborted = nullptr;
+        c.client.stop(); // copies (an SSE listener) keep the socket open
+        c.state.store(CONN_FREE, std::memory_order_release);
+    }
+
+    void send(int code, const char *type, const char *body, size_t len)
+    {
+        Connection &c = current();
+        if (c.headersSent)
+            return; // one status line per response
+        c.headersSent = true;
+
+        char head[160 + HTTP_RESPONSE_HEADER_BYTES];
+        int n = snprintf(head, sizeof(head), "HTTP/1.1 %d %s\r\n", code, statusText(code));
+        if (type && *type)
+            n += snprintf(head + n, sizeof(head) - n, "Content-Type: %s\r\n", type);
+        size_t length = c.contentLength == CONTENT_LENGTH_NOT_SET ? len : c.contentLength;
+        if (length != CONTENT_LENGTH_UNKNOWN && code != 304 && code >= 200)
+            n += snprintf(head + n, sizeof(head) - n, "Content-Length: %u\r\n", (unsigned)length);
+        n += snprintf(head + n, sizeof(head) - n, "Connection: close\r\n%.*s\r\n", (int)c.headersLen, c.headers);
+        c.client.write((const uint8_t *)head, (size_t)n < sizeof(head) ? n : sizeof(head) - 1);
+        sendContent(body, len);
+    }
+
+    static HTTPMethod parseMethod(const char *m)
+    {
+        return !strcmp(m, "POST") ? HTTP_POST : !strcmp(m, "PUT") ? HTTP_PUT : !strcmp(m, "DELETE") ? HTTP_DELETE : !strcmp(m, "HEAD") ? HTTP_HEAD : HTTP_GET;
+    }
+
+    static const char *statusText(int code)
+    {
+        switch (code)
+        {
+        case 200:
+            return "OK";
+        case 303:
+            return "See Other";
+        case 304:
+            return "Not Modified";
+        case 400:
+            return "Bad Request";
+        case 404:
+            return "Not Found";
+        case 413:
+            return "Payload Too Large";
+        case 500:
+            return "Internal Server Error";
+        case 503:
+            return "Service Unavailable";
+        }
+        return "";
+    }
+};
@@ -0,0 +1,123 @@
+// jsonScan.h — Minimal JSON object scanner for small request bodies
+// Walks {"key": value, "group": {"key": value}} without building a tree: fn(group, key, value,
+// isString) is called for every scalar member, with group "" at the top level. Numbers, true,
+// false and null are passed as their raw text; strings are unescaped (\" \\ \/ only). Arrays and
+// deeper nesting are rejected. Everything lives on the stack; names and values are truncated to
+// JSON_TOKEN_MAX - 1 characters.
+#pragma once
+
+#include <stddef.h>
+#include <string.h>
+
+#define JSON_TOKEN_MAX 32
+
+class JsonScanner
+{
+public:
+    explicit JsonScanner(const char *text) : _p(text) {}
+
+    template <class F>
+    bool scan(F fn)
+    {
+        skipSpace();
+        if (!object("", fn, 0))
+            return false;
+        skipSpace();
+        return !*_p;
+    }
+
+private:
+    const char *_p;
+
+    void skipSpace()
+    {
+        while (*_p == ' ' || *_p == '\t' || *_p == '\r' || *_p == '\n')
+            _p++;
+    }
+
+    bool string(char *out)
+    {
+        if (*_p != '"')
+            return false;
+        _p++;
+        size_t n = 0;
+        while (*_p && *_p != '"')
+        {
+            char c = *_p++;
+            if (c == '\\')
+            {
+                c = *_p++;
+                if (c != '"' && c != '\\' && c != '/')
+                    return false;
+            }
+            if (n + 1 < JSON_TOKEN_MAX)
+                out[n++] = c;
+        }
+        out[n] = '\0';
+        if (*_p != '"')
+            return false;
+        _p++;
+        return true;
+    }
+
+    // Number or literal, up to the next delimiter
+    bool bare(char *out)
+    {
+        size_t n = 0;
+        while (*_p && !strchr(",}] \t\r\n", *_p))
+        {
+            if (n + 1 < JSON_TOKEN_MAX)
+                out[n++] = *_p;
+            _p++;
+        }
+        out[n] = '\0';
+        return n > 0;
+    }
+
+    template <class F>
+    bool object(const char *group, F &fn, int depth)
+    {
+        if (*_p != '{')
+            return false;
+        _p++;
+        skipSpace();
+        if (*_p == '}')
+        {
+            _p++;
+            return true;
+        }
+        for (;;)
+        {
+            char key[JSON_TOKEN_MAX], value[JSON_TOKEN_MAX];
+            skipSpace();
+            if (!string(key))
+                return false;
+            skipSpace();
+            if (*_p++ != ':')
+                return false;
+            skipSpace();
+            if (*_p == '{')
+            {
+                if (depth > 0 || !object(key, fn, depth + 1))
+                    return false;
+            }
+            else if (*_p == '"')
+            {
+                if (!string(value) || !fn(group, key, value, true))
+                    return false;
+            }
+            else if (*_p == '[' || !bare(value) || !fn(group, key, value, false))
+                return false;
+            skipSpace();
+            if (*_p == ',')
+            {
+                _p++;
+                continue;
+            }
+            if (*_p != '}')
+                return false;
+            _p++;
+            return true;
+        }
+    }
+};
@@ -47,11 +47,14 @@ const char *labels[] = {"Bore", "Sump", "Motor", "U-ground", "O-head", "Tank",
 
 int drawTickerLine(TFT_eSprite &sprite);
 void updateTicker();
-void drawMenuLabels();
-void updateValue(int i, bool highlight);
-void drawAllValues();
-void drawStatusLine(int row, const char *label, const String &value, uint16_t fg = TFT_CYAN, uint16_t bg = TFT_BLACK, bool highlight = false);
-void drawStatusScreen(bool isBore);
+void flushPanel();
+void drawMenu(int menuIndex);
+void drawStatusScreen(uint8_t motor);
+void nextStatusPage();
+void drawPrompt(const char *line1, const char *line2);
+
+// Render task's copy of the controller state (renderTask.cpp); everything below draws from it
+ControllerView renderView;
 
 int drawTickerLine(TFT_eSprite &sprite)
 {
@@ -147,173 +150,294 @@ int drawTickerLine(TFT_eSprite &sprite)
     return msgW;
 }
 
+// ==== Ticker ====
+// The message is rendered into tickerStrip (8-bit, one glyph row tall) only when its text or colours
+// change, at most once a second while a countdown is below a minute. Each frame pushes the visible
+// window of the strip, so scrolling is one block write and no text drawing. If the strip cannot be
+// allocated the message is drawn into tickerSprite every frame instead.
+#define TICKER_FRAME_MS 20     // 50 FPS
+#define TICKER_STEP 2          // px per frame, 100 px/s
+#define TICKER_TEXT_Y 4        // glyph row inside the ticker band
+#define TICKER_GLYPH_H 16      // text size 2
+#define TICKER_STRIP_MAX 2400  // px; the strip takes width x TICKER_GLYPH_H bytes
+#define TICKER_PARTS (1 + MOTOR_COUNT)
+
+struct TickerText
+{
+    char part[TICKER_PARTS][64]; // IP, then one status per motor
+    uint16_t colour[TICKER_PARTS];
+};
+
+TFT_eSprite tickerStrip = TFT_eSprite(&tft);
+TickerText tickerShown = {};  // what tickerStrip holds
+int tickerWidth = 0;          // message width in px
+int tickerStripWidth = 0;     // allocated strip width, 0 = per-frame fallback
+bool tickerStale = true;      // clear the band before the next window
+
+void buildTickerText(TickerText &t)
+{
+    static const uint16_t motorColour[] = {TFT_BLUE, TFT_MAGENTA, TFT_CYAN, TFT_ORANGE};
+    memset(&t, 0, sizeof(t)); // padding compares equal
+    IPAddress ip = WiFi.localIP();
+    snprintf(t.part[0], sizeof(t.part[0]), "IP: %u.%u.%u.%u", ip[0], ip[1], ip[2], ip[3]);
+    t.colour[0] = TFT_GREEN;
+
+    for (uint8_t k = 0; k < MOTOR_COUNT; k++)
+    {
+        const MotorView &m = renderView.motor[k];
+        const Settings &s = m.settings;
+        char *out = t.part[1 + k];
+        size_t cap = sizeof(t.part[0]);
+        int mode = m.mode;
+        int remaining = mode == 1   ? (s.offTime * 60) - (int)((millis() - m.lastOffTime) / 1000)
+                        : mode == 3 ? (s.onTime * 60) - (int)((millis() - m.lastOnTime) / 1000)
+                                    : 0; // in sec
+        int len = snprintf(out, cap, " | %s Status:", motorPins[k].name);
+        if (mode == 1 || mode == 3)
+            snprintf(out + len, cap - len, "%s - Remaining Time: %d %s", mode == 1 ? "Waiting" : "ON",
+                     remaining > 60 ? remaining / 60 : remaining, remaining > 60 ? "Min" : "Sec");
+        else
+            snprintf(out + len, cap - len, "%s", mode == 2 ? m.errorMessage : mode == 4 ? "OFF" : "NA");
+        t.colour[1 + k] = m.error >= 2 ? TFT_RED : motorColour[k % (sizeof(motorColour) / sizeof(motorColour[0]))];
+    }
+}
+
+void renderTicker(const TickerText &t)
+{
+    int width = 0;
+    for (uint8_t i = 0; i < TICKER_PARTS; i++)
+        width += tickerSprite.textWidth(t.part[i]);
+    if (width > TICKER_STRIP_MAX)
+        width = TICKER_STRIP_MAX;
+
+    if (width > tickerStripWidth)
+    {
+        // Grow in 256 px steps so a countdown changing digits does not reallocate
+        int want = (width + 255) & ~255;
+        if (want > TICKER_STRIP_MAX)
+            want = TICKER_STRIP_MAX;
+        tickerStrip.deleteSprite();
+        tickerStrip.setColorDepth(8);
+        tickerStripWidth = tickerStrip.createSprite(want, TICKER_GLYPH_H) ? want : 0;
+        tickerStrip.setTextSize(2);
+        tickerStrip.setTextWrap(false);
+    }
+    if (tickerStripWidth)
+    {
+        tickerStrip.fillSprite(TFT_BLACK);
+        tickerStrip.setCursor(0, 0);
+        for (uint8_t i = 0; i < TICKER_PARTS; i++)
+        {
+            tickerStrip.setTextColor(t.colour[i], TFT_BLACK);
+            tickerStrip.print(t.part[i]);
+        }
+    }
+    if (width < tickerWidth)
+        tickerStale = true; // the old, longer tail is still on the glass
+    tickerWidth = width;
+    tickerShown = t;
+}
+
 void updateTicker()
 {
     static unsigned long lastScroll = 0;
-    if (millis() - lastScroll <= 40) // bottom scroll text
+    if (millis() - lastScroll < TICKER_FRAME_MS) // bottom scroll text
     {
         return;
     }
+    lastScroll = millis();
+
+    TickerText text;
+    buildTickerText(text);
+    if (memcmp(&text, &tickerShown, sizeof(text)))
+        renderTicker(text);
+
+    int top = tft.height() - tickerHeight;
+    if (!tickerStripWidth)
+    {
+        tickerSprite.fillSprite(TFT_BLACK);
+        tickerSprite.setCursor(tickerX, TICKER_TEXT_Y);
+        for (uint8_t i = 0; i < TICKER_PARTS; i++)
+        {
+            tickerSprite.setTextColor(text.colour[i], TFT_BLACK);
+            tickerSprite.print(text.part[i]);
+        }
+        tickerSprite.pushSprite(0, top);
+    }
+    else
+    {
+        if (tickerStale)
+        {
+            tft.fillRect(0, top, tft.width(), tickerHeight, TFT_BLACK);
+            tickerStale = false;
+        }
+        // Window of the strip that is on screen, then the column the message just left
+        int x0 = tickerX > 0 ? tickerX : 0;
+        int sx = x0 - tickerX;
+        int sw = min(tft.width() - x0, tickerWidth - sx);
+        if (sw > 0)
+            tickerStrip.pushSprite(x0, top + TICKER_TEXT_Y, sx, 0, sw, TICKER_GLYPH_H);
+        int end = tickerX + tickerWidth;
+        if (end >= 0 && end < tft.width())
+            tft.fillRect(end, top + TICKER_TEXT_Y, min(TICKER_STEP, tft.width() - end), TICKER_GLYPH_H, TFT_BLACK);
+    }
 
-    tickerSprite.fillSprite(TFT_BLACK);
-    // draw message into sprite
-    tickerSprite.setCursor(tickerX, 4); // small margin top
-    // tickerSprite.print(tickerMsg);
-    int boreRemmainingOffTime = (boreSettings.offTime * 60) - ((millis() - boreLastOffTime) / 1000); // in sec
-    int boreRemmainingOnTime = (boreSettings.onTime * 60) - ((millis() - boreLastOnTime) / 1000);    // in sec
-    int sumpRemmainingOffTime = (sumpSettings.offTime * 60) - ((millis() - sumpLastOffTime) / 1000); // in sec
-    int sumpRemmainingOnTime = (sumpSettings.onTime * 60) - ((millis() - sumpLastOnTime) / 1000);    // in sec
-
-    String tickerMsg1 = String("IP: ") + WiFi.localIP().toString();
-    String tickerMsg2 = " | Bore Status:" +
-                        (boreMode == 1
-                             ? String("Waiting - Remaining Time: ") + (boreRemmainingOffTime > 60 ? String(boreRemmainingOffTime / 60) + " Min" : String(boreRemmainingOffTime) + " Sec")
-                         : boreMode == 2
-                             ? boreErrorMessage
-                         : boreMode == 3
-                             ? String("ON - Remaining Time: ") + (boreRemmainingOnTime > 60 ? String(boreRemmainingOnTime / 60) + " Min" : String(boreRemmainingOnTime) + " Sec")
-                         : boreMode == 4
-                             ? "OFF"
-                             : "NA");
-    String tickerMsg3 = " | Sump Status:" +
-                        (sumpMode == 1
-                             ? String("Waiting - Remaining Time: ") + (sumpRemmainingOffTime > 60 ? String(sumpRemmainingOffTime / 60) + " Min" : String(sumpRemmainingOffTime) + " Sec")
-                         : sumpMode == 2
-                             ? sumpErrorMessage
-                         : sumpMode == 3
-                             ? String("ON - Remaining Time: ") + (sumpRemmainingOnTime > 60 ? String(sumpRemmainingOnTime / 60) + " Min" : String(sumpRemmainingOnTime) + " Sec")
-                         : sumpMode == 4
-                             ? "OFF"
-                             : "NA");
-
-    // --- Measure pixel width properly ---
-    int msgW = tickerSprite.textWidth(tickerMsg1) +
-               tickerSprite.textWidth(tickerMsg2) +
-               tickerSprite.textWidth(tickerMsg3);
-
-    // --- IP section ---
-    tickerSprite.setTextColor(TFT_GREEN, TFT_BLACK);
-    tickerSprite.print(tickerMsg1);
-
-    // --- Bore error ---
-    tickerSprite.setTextColor((boreError >= 3) ? TFT_RED : TFT_BLUE, TFT_BLACK);
-    tickerSprite.print(tickerMsg2);
-
-    // --- Sump error ---
-    tickerSprite.setTextColor((sumpError >= 3) ? TFT_RED : TFT_MAGENTA, TFT_BLACK);
-    tickerSprite.print(tickerMsg3);
-
-    // push sprite at bottom of screen
-    tickerSprite.pushSprite(0, tft.height() - tickerHeight);
-    // move left
-    tickerX -= 4; // scroll speed
-
-    if (tickerX < -msgW)
+    tickerX -= TICKER_STEP; // scroll speed
+    if (tickerX < -tickerWidth)
     {
         tickerX = tft.width(); // restart from right
     }
-    lastScroll=millis();
 }
 
-// ==== Draw Labels for Current Page ====
-void drawMenuLabels()
+// ==== Retained panel: everything above the ticker (screenCompositor.h) ====
+// Title, then ROWS_PER_PAGE rows of label + value. The menu and status screens only describe what
+// they want; flushPanel() repaints the widgets that changed. The two prompt lines overlap rows 1-2,
+// so the render task invalidates the panel when a prompt comes or goes.
+enum : uint8_t
+{
+    W_TITLE,
+    W_LABEL,
+    W_VALUE = W_LABEL + ROWS_PER_PAGE,
+    W_PROMPT = W_VALUE + ROWS_PER_PAGE,
+    W_COUNT = W_PROMPT + 2
+};
+
+#define ROW_Y(row) (34 + (row) * ROW_HEIGHT)
+#define LABEL_X 6
+#define VALUE_X 222
+#define WIDGET_HEIGHT 22
+
+Compositor<W_COUNT> panel(DISPLAY_WIDTH, DISPLAY_HEIGHT - tickerHeight, TFT_BLACK);
+
+struct TftPainter
 {
-    tft.fillScreen(TFT_BLACK);
-    tft.setTextSize(2);
-
-    // Title
-    tft.setTextColor(TFT_YELLOW, TFT_BLACK);
-    tft.setCursor(10, 5);
-    tft.print("Bore Settings Pg ");
-    tft.print(currentPage + 1);
-
-    // Labels
-    tft.setTextColor(TFT_WHITE, TFT_BLACK);
-    for (int i = 0; i < ROWS_PER_PAGE; i++)
+    TftPainter()
     {
-        int item = currentPage * ROWS_PER_PAGE + i;
-        if (item >= MENU_COUNT)
-            break;
-        int y = 30 + i * ROW_HEIGHT;
-        tft.setCursor(10, y);
-        tft.print(labels[item]);
+        tft.setTextSize(2);
+        tft.setTextDatum(TL_DATUM);
     }
-    currentPage++;
+    void fill(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t colour)
+    {
+        tft.fillRect(x, y, w, h, colour);
+    }
+    void text(int16_t x, int16_t y, const char *s, uint16_t fg, uint16_t bg)
+    {
+        tft.setTextColor(fg, bg);
+        tft.setCursor(x, y);
+        tft.print(s);
+    }
+    int16_t textWidth(const char *s)
+    {
+        return tft.textWidth(s);
+    }
+    int16_t fontHeight()
+    {
+        return tft.fontHeight();
+    }
+};
+
+void flushPanel()
+{
+    static bool placed = false;
+    if (!placed)
+    {
+        panel.place(W_TITLE, 0, 2, DISPLAY_WIDTH, WIDGET_HEIGHT, ALIGN_CENTRE);
+        for (uint8_t i = 0; i < ROWS_PER_PAGE; i++)
+        {
+            panel.place(W_LABEL + i, LABEL_X, ROW_Y(i) - 3, VALUE_X - LABEL_X, WIDGET_HEIGHT);
+            panel.place(W_VALUE + i, VALUE_X, ROW_Y(i) - 3, DISPLAY_WIDTH - VALUE_X, WIDGET_HEIGHT);
+        }
+        for (uint8_t i = 0; i < 2; i++)
+            panel.place(W_PROMPT + i, 0, ROW_Y(1 + i) - 3, DISPLAY_WIDTH, WIDGET_HEIGHT, ALIGN_CENTRE);
+        placed = true;
+    }
+    TftPainter painter;
+    panel.flush(painter);
 }
-// ==== Draw/Update a Value ====
-void updateValue(int i, bool highlight)
+
+void setTitle(const char *title)
 {
-    int relRow = i % ROWS_PER_PAGE;
-    int y = 30 + relRow * ROW_HEIGHT;
-    int valX = 230; // shifted a bit right
-    String val;
+    panel.set(W_TITLE, title, TFT_YELLOW, TFT_BLACK);
+    panel.set(W_PROMPT, "", TFT_YELLOW, TFT_BLACK);
+    panel.set(W_PROMPT + 1, "", TFT_WHITE, TFT_BLACK);
+}
 
-    switch (i)
+void setRow(uint8_t row, const char *label, const char *value, uint16_t fg = TFT_CYAN, uint16_t bg = TFT_BLACK)
+{
+    panel.set(W_LABEL + row, label, TFT_WHITE, TFT_BLACK);
+    panel.set(W_VALUE + row, value, fg, bg);
+}
+
+// ==== Settings menu ====
+// menuIndex 0..11 edits the bore, 12..23 the sump; the row being edited has a blue band
+void formatMenuValue(const Settings &s, int index, char *out, size_t cap)
+{
+    switch (index)
     {
     case 0:
-        val = boreSettings.detectVoltage ? "ON" : "OFF";
+        snprintf(out, cap, "%s", s.detectVoltage ? "ON" : "OFF");
         break;
     case 1:
-        val = String(boreSettings.overVoltage, 1) + " V";
+        snprintf(out, cap, "%.1f V", s.overVoltage);
         break;
     case 2:
-        val = String(boreSettings.underVoltage, 1) + " V";
+        snprintf(out, cap, "%.1f V", s.underVoltage);
         break;
     case 3:
-        val = boreSettings.detectCurrent ? "ON" : "OFF";
+        snprintf(out, cap, "%s", s.detectCurrent ? "ON" : "OFF");
         break;
     case 4:
-        val = String(boreSettings.overCurrent, 1) + " A";
+        snprintf(out, cap, "%.1f A", s.overCurrent);
         break;
     case 5:
-        val = String(boreSettings.underCurrent, 1) + " A";
+        snprintf(out, cap, "%.1f A", s.underCurrent);
         break;
     case 6:
-        val = boreSettings.dryRun ? "ON" : "OFF";
+        snprintf(out, cap, "%s", s.dryRun ? "ON" : "OFF");
         break;
     case 7:
-        val = String(boreSettings.minPF, 2);
+        snprintf(out, cap, "%.2f", s.minPF);
         break;
     case 8:
-        val = boreSettings.cyclicTimer ? "ON" : "OFF";
+        snprintf(out, cap, "%s", s.cyclicTimer ? "ON" : "OFF");
         break;
     case 9:
-        val = String(boreSettings.onTime) + " Min";
+        snprintf(out, cap, "%u Min", s.onTime);
         break;
     case 10:
-        val = String(boreSettings.offTime) + " Min";
+        snprintf(out, cap, "%u Min", s.offTime);
         break;
-    case 11:
-        val = String(boreSettings.PowerOnDelay) + " Sec";
+    default:
+        snprintf(out, cap, "%u Sec", s.PowerOnDelay);
         break;
     }
-
-    // Clear old area
-    tft.fillRect(valX - 2, y - 2, 150, 28, TFT_BLACK);
-
-    // Draw new value
-    if (highlight)
-    {
-        tft.fillRect(valX - 2, y - 2, 150, 28, TFT_BLUE);
-        tft.setTextColor(TFT_WHITE, TFT_BLUE);
-    }
-    else
-    {
-        tft.setTextColor(TFT_CYAN, TFT_BLACK);
-    }
-    tft.setCursor(valX, y);
-    tft.print(val);
 }
 
-// ==== Redraw values for current page ====
-void drawAllValues()
+void drawMenu(int menuIndex)
 {
-    for (int i = currentPage * ROWS_PER_PAGE; i < (currentPage + 1) * ROWS_PER_PAGE; i++)
+    uint8_t motor = menuIndex < MENU_COUNT ? MOTOR_BORE : MOTOR_SUMP;
+    int index = menuIndex % MENU_COUNT;
+    int page = index / ROWS_PER_PAGE;
+    const Settings &s = renderView.motor[motor].settings;
+
+    char text[WIDGET_TEXT];
+    snprintf(text, sizeof(text), "%s Settings Pg %d", motorPins[motor].name, page + 1);
+    setTitle(text);
+    for (int row = 0; row < ROWS_PER_PAGE; row++)
     {
-        if (i >= MENU_COUNT)
-            break;
-        updateValue(i, (menuIndex == i) && editing);
+        int item = page * ROWS_PER_PAGE + row;
+        if (item >= MENU_COUNT)
+        {
+            setRow(row, "", "");
+            continue;
+        }
+        formatMenuValue(s, item, text, sizeof(text));
+        if (item == index)
+            setRow(row, labels[6 + item], text, TFT_WHITE, TFT_BLUE);
+        else
+            setRow(row, labels[6 + item], text);
     }
+    flushPanel();
 }
 
 // void setup()
@@ -404,266 +528,139 @@ void drawAllValues()
 //     tft.setTextColor(TFT_CYAN, TFT_BLACK);
 //     tft.print(value);
 // }
-void drawStatusLine(int row, const char *label, const String &value, uint16_t fg, uint16_t bg, bool highlight)
+// ==== Status pages ====
+// One motor's readings and settings, ROWS_PER_PAGE rows a page. Redrawn every second (only changed
+// rows reach the glass); nextStatusPage() moves on every statusInterval.
+struct StatusItem
+{
+    char label[WIDGET_TEXT];
+    char value[12];
+    uint16_t fg;
+    uint16_t bg;
+};
+
+// Worst case, a motor with a source float and every protection on: 3 readings, OHT, source, motor,
+// voltage 1+2, current 1+2, dry run 1+1, cyclic timer 1+2, power-on delay
+#define STATUS_ITEMS_MAX (3 + 1 + 1 + 1 + 3 + 3 + 2 + 3 + 1)
+#define STATUS_ITEMS 18
+static_assert(STATUS_ITEMS >= STATUS_ITEMS_MAX, "STATUS_ITEMS is smaller than the longest status list");
+
+uint8_t statusItems(uint8_t motor, StatusItem *items)
 {
-    int y = 40 + row * ROW_HEIGHT;
-    int valX = 230;
-    tft.setCursor(10, y);
-    tft.setTextColor(TFT_WHITE, TFT_BLACK);
-    tft.print(label);
-
-    // If highlight needed, draw a "band" behind value
-    if (highlight)
+    const MotorPins &pins = motorPins[motor];
+    const Settings &s = renderView.motor[motor].settings;
+    int mode = renderView.motor[motor].mode;
+    const PzemReading meter = meterFor(motor).read(); // this motor's own PZEM
+    uint8_t n = 0;
+
+    auto add = [&](const char *label, const char *label2, uint16_t fg, uint16_t bg, const char *fmt, ...)
     {
-        int textHeight = 16;             // for text size 2 (approx 8px * 2)
-        int bandHeight = textHeight + 6; // add padding
-        int bandY = y - 2;               // adjust to center nicely
-        tft.fillRect(valX - 4, bandY, 80, bandHeight, bg);
-    }
+        if (n >= STATUS_ITEMS)
+            return; // never past the caller's array
+        StatusItem &it = items[n++];
+        if (label2)
+            snprintf(it.label, sizeof(it.label), "%s %s %s", pins.name, label, label2);
+        else
+            snprintf(it.label, sizeof(it.label), "%s %s", pins.name, label);
+        va_list args;
+        va_start(args, fmt);
+        vsnprintf(it.value, sizeof(it.value), fmt, args);
+        va_end(args);
+        it.fg = fg;
+        it.bg = bg;
+    };
+    const char *onOff[] = {"OFF", "ON"};
 
-    // Print value over background
-    tft.setCursor(valX, y);
-    tft.setTextColor(fg, highlight ? bg : TFT_BLACK);
-    tft.print(value);
-}
+    bool voltageBad = meter.voltage > s.overVoltage || meter.voltage < s.underVoltage;
+    bool currentBad = meter.current > s.overCurrent || meter.current < s.underCurrent;
+    add(labels[18], nullptr, TFT_CYAN, voltageBad ? TFT_RED : TFT_BLACK, "%.0f V", meter.voltage);
+    add(labels[19], nullptr, TFT_CYAN, currentBad ? TFT_RED : TFT_BLACK, "%.1f A", meter.current);
+    add(labels[21], nullptr, TFT_CYAN, meter.pf < s.minPF ? TFT_RED : TFT_BLACK, "%.2f", meter.pf);
 
-void drawStatusScreen(bool isBore)
-{
-    // Serial.println("ENtering drawStatusScreen()");
-    Settings &s = isBore ? boreSettings : sumpSettings;
-    String prefix = isBore ? labels[0] : labels[1];
-    // tickerMsg = "IP: " + WiFi.localIP().toString() + " | Bore Error:" + boreErrorMessage + " | Sump error: " + sumpErrorMessage;
-
-    String lines[24];
-    int count = 0;
-    lines[count++] = prefix + " " + String(labels[18]) + ": " + String(voltage, 0) + " V";                                                                      // item 0
-    lines[count++] = prefix + " " + String(labels[19]) + ": " + String(isBore ? (boreMotorRunning ? current : 0) : (sumpMotorRunning ? current : 0), 1) + " A"; // item 1
-    lines[count++] = prefix + " " + String(labels[21]) + ": " + String(isBore ? (boreMotorRunning ? pf : 0) : (sumpMotorRunning ? pf : 0));                     // item 2
-
-    // Tank + Motor item 3
-    lines[count++] = prefix + " " + String(labels[4]) + " " + String(labels[5]) + ": " + (isBore ? digitalRead(FLOAT_BORE_OHT_PIN) ? "FULL" : "LOW" : digitalRead(FLOAT_SUMP_OHT_PIN) ? "FULL"
-                                                                                                                                                                                      : "LOW"); // item 3
-    if (!isBore)
-    {                                                                                                                                              // item 4
-        lines[count++] = prefix + " " + String(labels[3]) + " " + String(labels[5]) + ": " + (digitalRead(FLOAT_SUMP_UGT_PIN) ? "FULL" : "EMPTY"); // or LOW
+    bool full = floatInputs.level(pins.ohtPin);
+    add(labels[4], labels[5], full ? TFT_BLACK : TFT_CYAN, full ? TFT_GREEN : TFT_RED, "%s", full ? "FULL" : "LOW");
+    if (pins.sourcePin != NO_FLOAT)
+    {
+        full = floatInputs.level(pins.sourcePin);
+        add(labels[3], labels[5], full ? TFT_BLACK : TFT_CYAN, full ? TFT_GREEN : TFT_RED, "%s", full ? "FULL" : "EMPTY");
     }
-    // item 4 or 5
-    lines[count++] = prefix + " " + String(labels[2]) + ": " + String(isBore ? (boreMode == 3 ? "ON" : boreMode == 4 ? "OFF"
-                                                                                                   : boreMode == 1   ? "Waiting"
-                                                                                                   : boreMode == 2   ? "Critic"
-                                                                                                                     : 0)
-                                                                             : (sumpMode == 3 ? "ON" : sumpMode == 4 ? "OFF"
-                                                                                                   : sumpMode == 1   ? "Waiting"
-                                                                                                   : sumpMode == 2   ? "Critic"
-                                                                                                                     : 0)); // or OFF
-    // Voltage detect item
-    lines[count++] = prefix + " " + String(labels[6]) + ": " + (s.detectVoltage ? "ON" : "OFF");
+
+    if (mode == 3)
+        add(labels[2], nullptr, TFT_BLACK, TFT_GREEN, "ON");
+    else if (mode == 1)
+        add(labels[2], nullptr, TFT_BLACK, TFT_YELLOW, "Waiting");
+    else if (mode == 2)
+        add(labels[2], nullptr, TFT_CYAN, TFT_RED, "Critic");
+    else
+        add(labels[2], nullptr, TFT_CYAN, TFT_BLACK, "OFF");
+
+    add(labels[6], nullptr, TFT_CYAN, TFT_BLACK, "%s", onOff[s.detectVoltage]);
     if (s.detectVoltage)
     {
-        lines[count++] = prefix + " " + String(labels[7]) + ": " + String(s.overVoltage, 0) + " V";
-        lines[count++] = prefix + " " + String(labels[8]) + ": " + String(s.underVoltage, 0) + " V";
+        add(labels[7], nullptr, TFT_CYAN, TFT_BLACK, "%.0f V", s.overVoltage);
+        add(labels[8], nullptr, TFT_CYAN, TFT_BLACK, "%.0f V", s.underVoltage);
     }
-
-    // Current detect
-    lines[count++] = prefix + " " + String(labels[9]) + ": " + (s.detectCurrent ? "ON" : "OFF");
+    add(labels[9], nullptr, TFT_CYAN, TFT_BLACK, "%s", onOff[s.detectCurrent]);
     if (s.detectCurrent)
     {
-        lines[count++] = prefix + " " + String(labels[10]) + ": " + String(s.overCurrent, 1) + " A";
-        lines[count++] = prefix + " " + String(labels[11]) + ": " + String(s.underCurrent, 1) + " A";
+        add(labels[10], nullptr, TFT_CYAN, TFT_BLACK, "%.1f A", s.overCurrent);
+        add(labels[11], nullptr, TFT_CYAN, TFT_BLACK, "%.1f A", s.underCurrent);
     }
-
-    // Dry run detect
-    lines[count++] = prefix + " " + String(labels[12]) + ": " + (s.dryRun ? "ON" : "OFF");
+    add(labels[12], nullptr, TFT_CYAN, TFT_BLACK, "%s", onOff[s.dryRun]);
     if (s.dryRun)
-    {
-        lines[count++] = prefix + " " + String(labels[13]) + ": " + String(s.minPF, 2);
-    }
-
-    // Timer
-    lines[count++] = prefix + " " + String(labels[14]) + ": " + (s.cyclicTimer ? "ON" : "OFF");
+        add(labels[13], nullptr, TFT_CYAN, TFT_BLACK, "%.2f", s.minPF);
+    add(labels[14], nullptr, TFT_CYAN, TFT_BLACK, "%s", onOff[s.cyclicTimer]);
     if (s.cyclicTimer)
     {
-        lines[count++] = prefix + " " + String(labels[15]) + ": " + String(s.onTime) + " Min";
-        lines[count++] = prefix + " " + String(labels[16]) + ": " + String(s.offTime) + " Min";
+        add(labels[15], nullptr, TFT_CYAN, TFT_BLACK, "%u Min", s.onTime);
+        add(labels[16], nullptr, TFT_CYAN, TFT_BLACK, "%u Min", s.offTime);
     }
-    lines[count++] = prefix + " " + String(labels[17]) + ": " + String(s.PowerOnDelay) + " Sec";
-
-    // Draw current page, leaving bottom 20px free
-    // tft.fillScreen(TFT_BLACK);
-    tft.fillRect(0, 0, tft.width(), tft.height() - tickerHeight, TFT_BLACK);
-    // tft.setTextSize(2);
-    // tft.setTextColor(TFT_YELLOW, TFT_BLACK);
-    // tft.setCursor(10, 5);
-    // tft.print(isBore ? labels[0] : labels[1]); // Bore or Sump
-    // tft.print(" Status Page ");
-    // tft.print(currentPage + 1);
-
-    String header = String(isBore ? labels[0] : labels[1]) + " Status Page " + String(currentPage + 1);
-
-    tft.setTextSize(2);              // use the same size you’ll actually draw with
-    int w = tft.textWidth(header);   // pixel width of the string
-    int x = (DISPLAY_WIDTH - w) / 2; // center horizontally
-    int y = 5;                       // top margin
-
-    tft.setTextColor(TFT_YELLOW, TFT_BLACK);
-    tft.setCursor(x, y);
-    tft.print(header);
-
-    // Draw rows but stop before ticker area
-    for (int i = 0; i < ROWS_PER_PAGE; i++)
+    add(labels[17], nullptr, TFT_CYAN, TFT_BLACK, "%u Sec", s.PowerOnDelay);
+    return n;
+}
+
+void drawStatusScreen(uint8_t motor)
+{
+    StatusItem items[STATUS_ITEMS];
+    uint8_t count = statusItems(motor, items);
+    if (currentPage * ROWS_PER_PAGE >= count)
+        currentPage = 0;
+
+    char title[WIDGET_TEXT];
+    snprintf(title, sizeof(title), "%s Status Page %d", motorPins[motor].name, currentPage + 1);
+    setTitle(title);
+    for (int row = 0; row < ROWS_PER_PAGE; row++)
     {
-        int item = currentPage * ROWS_PER_PAGE + i;
-        if (item >= count)
-            break;
-
-        int sep = lines[item].indexOf(':');
-
-        // if (sep > 0)
-        // {
-        //     String label = lines[item].substring(0, sep);
-        //     String value = lines[item].substring(sep + 2);
-        //     drawStatusLine(i, label.c_str(), value);
-        // }
-        if (sep > 0)
-        {
-            String label = lines[item].substring(0, sep);
-            String value = lines[item].substring(sep + 2);
-
-            // --- Default colors ---
-            uint16_t fg = TFT_CYAN;
-            uint16_t bg = TFT_BLACK;
-            bool highlight = false;
-            // Voltage check (your line[0] -> voltage)
-            // if (item == 0)
-            // {
-            //     float v = value.toFloat();
-            //     if (v > s.overVoltage || v < s.underVoltage)
-            //     {
-            //         highlight = true;
-            //     }
-            // }
-
-            // // Current check (your line[1] -> current)
-            // if (item == 1)
-            // {
-            //     float c = value.toFloat();
-            //     if (c > s.overCurrent || c < s.underCurrent)
-            //     {
-            //         highlight = true;
-            //     }
-            // }
-
-            // if (item == 2)
-            // { // PF line
-            //     float p = value.toFloat();
-            //     if (p < s.minPF)
-            //     {
-            //         highlight = true;
-            //     }
-            // }
-            // if (item == 3 && value == "LOW")
-            // {
-            //         highlight = true;
-            // }
-            // if (item == 4 && value == "EMPTY")
-            // {
-            //         highlight = true;
-            // }
-            // if ((item == 4 && isBore) || (item == 5 && !isBore))
-            // {
-            //     if (value == "Critical" || value == "Waiting")
-            //     {
-            //         highlight = true;
-            //     }
-            // }
-
-            // Voltage check
-            if (label.indexOf("Voltage") >= 0 && label.indexOf("Detect") < 0)
-            {
-                float v = value.toFloat();
-                if (v > s.overVoltage || v < s.underVoltage)
-                {
-
-                    highlight = true;
-                    bg = TFT_RED;
-                }
-            }
-
-            // Current check
-            else if (label.indexOf("Current") >= 0 && label.indexOf("Detect") < 0)
-            {
-                float c = value.toFloat();
-                if (c > s.overCurrent || c < s.underCurrent)
-                {
-
-                    highlight = true;
-                    bg = TFT_RED;
-                }
-            }
-
-            // PF check
-            else if (label.indexOf("PF") >= 0)
-            {
-                float p = value.toFloat();
-                if (p < s.minPF)
-                {
-                    highlight = true;
-                    bg = TFT_RED;
-                }
-            }
-            // Tank status check
-            else if (label.indexOf("Tank") >= 0)
-            {
-                if (value == "FULL")
-                {
-                    fg = TFT_BLACK; // Green text
-                    bg = TFT_GREEN; // No background highlight
-                }
-                else if (value == "EMPTY" || value == "LOW")
-                {
-                    // fg = TFT_CYAN; // Normal cyan text
-                    // optionally:
-                    // fg = TFT_CYAN;
-                    bg = TFT_RED; // uncomment if you want LOW to show warning
-                }
-                highlight = true;
-            }
-            // Motor status check
-            else if (label.indexOf("Motor") >= 0)
-            {
-                highlight = true;
-                if (value == "Critic")
-                {
-                    bg = TFT_RED;
-                }
-                else if (value == "Waiting")
-                {
-                    bg = TFT_YELLOW;
-                    fg = TFT_BLACK;
-                }
-                else if (value == "ON")
-                {
-                    bg = TFT_GREEN;
-                    fg = TFT_BLACK;
-                }
-            }
-
-            drawStatusLine(i, label.c_str(), value, fg, bg, highlight);
-        }
+        int item = currentPage * ROWS_PER_PAGE + row;
+        if (item < count)
+            setRow(row, items[item].label, items[item].value, items[item].fg, items[item].bg);
+        else
+            setRow(row, "", "");
     }
+    flushPanel();
+}
 
-    // Advance to next page
+// Next page of this motor, or the first page of the next motor
+void nextStatusPage()
+{
+    StatusItem items[STATUS_ITEMS];
+    uint8_t count = statusItems(showingMotor, items);
     currentPage++;
     if (currentPage * ROWS_PER_PAGE >= count)
     {
         currentPage = 0;
-        if (isBore)
-        {
-            showingBore = 0;
-        }
-        else
-        {
-            showingBore = 1;
-        }
+        showingMotor = (showingMotor + 1) % MOTOR_COUNT;
     }
 }
+
+// ==== Prompts ====
+// Calibration and start-up messages: two centred lines in place of the status rows
+void drawPrompt(const char *line1, const char *line2)
+{
+    panel.set(W_TITLE, "", TFT_YELLOW, TFT_BLACK);
+    for (int row = 0; row < ROWS_PER_PAGE; row++)
+        setRow(row, "", "");
+    panel.set(W_PROMPT, line1, TFT_YELLOW, TFT_BLACK);
+    panel.set(W_PROMPT + 1, line2, TFT_WHITE, TFT_BLACK);
+    flushPanel();
+}
@@ -0,0 +1,736 @@
+// motorControl.cpp — Pump decision logic (status checks, start/stop, start arbitration, auto control)
+// Hardware is reached only through ControlIO so the same code runs on the ESP32 and in the
+// host simulator (src/sim). Included from main.cpp like the other modules in include/.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <math.h>
+#include <boardPins.h>
+#include <pzemSnapshot.h>
+#include <pzemStats.h>
+#include <pzemBus.h>
+#include <floatInputs.h>
+#include <pumpArbiter.h>
+#include <eventJournal.h>
+#include <runLog.h>
+
+#ifndef HIGH
+#define HIGH 1
+#define LOW 0
+#endif
+
+// ---------------- Injectable I/O ----------------
+struct ControlIO
+{
+    uint32_t (*now)();                             // ms clock, wraps like millis() on the ESP32
+    void (*writePin)(uint8_t pin, uint8_t level);  // motor relays
+    void (*log)(const char *fmt, ...);             // Serial.printf on target
+    void (*journal)(const JournalRecord &record);  // event journal; stamps seq/time (may be null)
+};
+
+extern ControlIO io; // defined by main.cpp (target) or the simulator
+
+struct Settings
+{
+    float overVoltage = 250.0;
+    float underVoltage = 180.0;
+    float overCurrent = 6.5;
+    float underCurrent = 0.3;
+    float minPF = 0.3;
+    unsigned int PowerOnDelay = 5; // sec
+    unsigned int onTime = 5;       // min
+    unsigned int offTime = 15;     // min
+    bool dryRun = false;
+    bool detectVoltage = false;
+    bool detectCurrent = false;
+    bool cyclicTimer = false;
+    // Protection rules look at the last tripWindow seconds of samples (0 = latest sample only):
+    // V and OC trip on the window mean, UC and dry run only when every sample is below the limit
+    unsigned int tripWindow = 3; // sec
+};
+
+// ---------------- Motor channels ----------------
+// One row per pump, highest priority first. Rows 0 and 1 are the bore and sump every board has;
+// define the BORE2_* or BOOSTER_* pins (boardPins.h or build_flags) to add Bore2 and Booster, four
+// pumps at most. The extra rows are controlled, metered and logged like the first two, but the
+// front-panel menu and the settings form only edit Bore and Sump; use /api/settings for the rest.
+// Every float named here must also be listed in floatPins.
+#define NO_FLOAT 0xFF // channel has no source tank float
+
+#ifdef PZEM_SHARED_METER
+#define MOTOR_METER(ch) 0 // everything on one PZEM
+#else
+#define MOTOR_METER(ch) (ch) // one PZEM per motor, same order as pzemAddress
+#endif
+
+struct MotorPins
+{
+    const char *name;
+    uint8_t relayPin;
+    uint8_t ledPin;
+    uint8_t ohtPin;    // destination tank float: 0 = LOW (pump needed), 1 = full
+    uint8_t sourcePin; // source tank float (NO_FLOAT if the pump draws from a bore)
+    uint8_t meter;     // PZEM channel
+};
+
+constexpr MotorPins motorPins[] = {
+    {"Bore", BORE_MOTOR_RELAY_PIN, BORE_MOTOR_STATUS_LED, FLOAT_BORE_OHT_PIN, NO_FLOAT, MOTOR_METER(0)},
+    {"Sump", SUMP_MOTOR_RELAY_PIN, SUMP_MOTOR_STATUS_LED, FLOAT_SUMP_OHT_PIN, FLOAT_SUMP_UGT_PIN, MOTOR_METER(1)},
+#ifdef BORE2_MOTOR_RELAY_PIN
+    {"Bore2", BORE2_MOTOR_RELAY_PIN, BORE2_MOTOR_STATUS_LED, FLOAT_BORE2_OHT_PIN, NO_FLOAT, MOTOR_METER(2)},
+#endif
+#ifdef BOOSTER_MOTOR_RELAY_PIN
+    {"Booster", BOOSTER_MOTOR_RELAY_PIN, BOOSTER_MOTOR_STATUS_LED, FLOAT_BOOSTER_OHT_PIN, FLOAT_BOOSTER_SRC_PIN, MOTOR_METER(3)},
+#endif
+};
+
+constexpr uint8_t MOTOR_COUNT = sizeof(motorPins) / sizeof(motorPins[0]);
+static_assert(MOTOR_COUNT >= 2 && MOTOR_COUNT <= 4, "motorPins needs 2..4 rows");
+
+enum : uint8_t
+{
+    MOTOR_BORE = 0,
+    MOTOR_SUMP = 1
+};
+
+// Float switches, sampled every FLOAT_SAMPLE_MS by the timer ISR (target) or the simulator
+constexpr uint8_t floatPins[] = {
+    FLOAT_BORE_OHT_PIN, FLOAT_SUMP_UGT_PIN, FLOAT_SUMP_OHT_PIN,
+#ifdef BORE2_MOTOR_RELAY_PIN
+    FLOAT_BORE2_OHT_PIN,
+#endif
+#ifdef BOOSTER_MOTOR_RELAY_PIN
+    FLOAT_BOOSTER_OHT_PIN, FLOAT_BOOSTER_SRC_PIN,
+#endif
+};
+static_assert(floatPinsInWord(floatPins, sizeof(floatPins)), "float switches must be on GPIO 0-31 (GPIO_IN_REG)");
+FloatInputs<sizeof(floatPins)> floatInputs(floatPins);
+
+// One PZEM for every motor by default; with -D PZEM_METER_PER_MOTOR one per motor (pzemBus.h)
+#ifdef PZEM_SHARED_METER
+constexpr uint8_t pzemAddress[] = {PZEM_GENERAL_ADDR};
+#else
+constexpr uint8_t pzemAddress[] = {
+    PZEM_BORE_ADDR, PZEM_SUMP_ADDR,
+#ifdef BORE2_MOTOR_RELAY_PIN
+    PZEM_BORE2_ADDR,
+#endif
+#ifdef BOOSTER_MOTOR_RELAY_PIN
+    PZEM_BOOSTER_ADDR,
+#endif
+};
+#endif
+constexpr uint8_t PZEM_CHANNELS = sizeof(pzemAddress);
+
+PzemSnapshot pzemSnapshots[PZEM_CHANNELS]; // written by publishMeter(), read everywhere else via read()
+
+// Per motor sliding window over its meter's samples, restarted whenever the motor starts or stops
+#define PZEM_WINDOW_SAMPLES 64 // 12.8 s at PZEM_POLL_INTERVAL_MS, upper bound for tripWindow
+#define TRIP_WINDOW_MAX (PZEM_WINDOW_SAMPLES * PZEM_POLL_INTERVAL_MS / 1000)
+
+struct MeterWindow
+{
+    uint32_t timestamp; // newest sample
+    WindowStats voltage;
+    WindowStats current;
+    WindowStats pf;
+};
+
+struct MotorWindow
+{
+    RollingWindow<PZEM_WINDOW_SAMPLES> voltage, current, pf;
+    bool running;
+};
+
+MotorWindow motorWindows[MOTOR_COUNT];         // pzemTask only
+Seqlock<MeterWindow> windowStats[MOTOR_COUNT]; // published summaries for checkSystemStatus() and the UI
+
+// Everything the control logic keeps per pump
+struct MotorChannel
+{
+    Settings settings;
+    char errorMessage[17] = "No ERROR";
+    bool running = false;
+    int error = 0;        // last checkSystemStatus() code
+    uint32_t lastOnTime = 0;
+    uint32_t lastOffTime = 0;
+    uint32_t lastErrorTime = 0;
+    uint32_t stabilizationStart = 0;
+};
+
+MotorChannel motors[MOTOR_COUNT];
+
+// The web page, menu and ticker show the first two channels under their original names
+Settings &boreSettings = motors[MOTOR_BORE].settings;
+Settings &sumpSettings = motors[MOTOR_SUMP].settings;
+char (&boreErrorMessage)[17] = motors[MOTOR_BORE].errorMessage;
+char (&sumpErrorMessage)[17] = motors[MOTOR_SUMP].errorMessage;
+bool &boreMotorRunning = motors[MOTOR_BORE].running;
+bool &sumpMotorRunning = motors[MOTOR_SUMP].running;
+int &boreError = motors[MOTOR_BORE].error;
+int &sumpError = motors[MOTOR_SUMP].error;
+uint32_t &boreLastOnTime = motors[MOTOR_BORE].lastOnTime;
+uint32_t &boreLastOffTime = motors[MOTOR_BORE].lastOffTime;
+uint32_t &sumpLastOnTime = motors[MOTOR_SUMP].lastOnTime;
+uint32_t &sumpLastOffTime = motors[MOTOR_SUMP].lastOffTime;
+
+bool powerFailed = 1; // set on boot (so motors can start once PowerOnDelay passed)
+
+// ---------------- Start arbitration ----------------
+// Motors never start directly: auto control and the manual buttons queue a request and arbitrate()
+// starts requests in key order (table order, aged by waiting time) while the supply allows it.
+// Running motors are never preempted; a queued request waits for them to stop or for headroom.
+#define SUPPLY_BUDGET_MAX 63.0 // A, PZEM-004T range
+#define AGING_MINUTES_MAX 240
+
+struct SupplySettings
+{
+    float currentBudget = 0;       // A all running motors may draw together (0 = one motor at a time)
+    unsigned int agingMinutes = 15; // waiting this long is worth one step up the motor table
+};
+
+SupplySettings supplySettings;
+StartQueue<MOTOR_COUNT> startQueue;
+uint32_t lastGrantTime = 0;
+
+int stabilizationDelay = 10;
+
+// ---------------- Settings table ----------------
+// Every field the settings API (main.cpp) may change, with its limits. A field of SupplySettings
+// has supply set; the rest are per-motor Settings. Values outside [min, max] are refused.
+enum : uint8_t
+{
+    FIELD_FLOAT,
+    FIELD_UINT,
+    FIELD_BOOL
+};
+
+struct SettingField
+{
+    const char *name;
+    uint8_t type;
+    bool supply;
+    uint16_t offset;
+    float min;
+    float max;
+};
+
+#define MOTOR_FIELD(f, type, min, max) {#f, type, false, offsetof(Settings, f), min, max}
+#define SUPPLY_FIELD(f, type, min, max) {#f, type, true, offsetof(SupplySettings, f), min, max}
+
+const SettingField settingFields[] = {
+    MOTOR_FIELD(overVoltage, FIELD_FLOAT, 100, 300),
+    MOTOR_FIELD(underVoltage, FIELD_FLOAT, 0, 300),
+    MOTOR_FIELD(overCurrent, FIELD_FLOAT, 0, SUPPLY_BUDGET_MAX),
+    MOTOR_FIELD(underCurrent, FIELD_FLOAT, 0, SUPPLY_BUDGET_MAX),
+    MOTOR_FIELD(minPF, FIELD_FLOAT, 0, 1),
+    MOTOR_FIELD(PowerOnDelay, FIELD_UINT, 0, 3600),
+    MOTOR_FIELD(onTime, FIELD_UINT, 0, 1440),
+    MOTOR_FIELD(offTime, FIELD_UINT, 0, 1440),
+    MOTOR_FIELD(tripWindow, FIELD_UINT, 0, TRIP_WINDOW_MAX),
+    MOTOR_FIELD(dryRun, FIELD_BOOL, 0, 1),
+    MOTOR_FIELD(detectVoltage, FIELD_BOOL, 0, 1),
+    MOTOR_FIELD(detectCurrent, FIELD_BOOL, 0, 1),
+    MOTOR_FIELD(cyclicTimer, FIELD_BOOL, 0, 1),
+    SUPPLY_FIELD(currentBudget, FIELD_FLOAT, 0, SUPPLY_BUDGET_MAX),
+    SUPPLY_FIELD(agingMinutes, FIELD_UINT, 1, AGING_MINUTES_MAX),
+};
+#define SETTING_FIELDS (sizeof(settingFields) / sizeof(settingFields[0]))
+
+const SettingField *findSettingField(const char *name, bool supply)
+{
+    for (uint8_t i = 0; i < SETTING_FIELDS; i++)
+        if (settingFields[i].supply == supply && !strcmp(settingFields[i].name, name))
+            return &settingFields[i];
+    return nullptr;
+}
+
+float getSettingField(const void *base, const SettingField &f)
+{
+    const uint8_t *p = (const uint8_t *)base + f.offset;
+    if (f.type == FIELD_FLOAT)
+        return *(const float *)p;
+    if (f.type == FIELD_UINT)
+        return *(const unsigned int *)p;
+    return *(const bool *)p;
+}
+
+// False (and base untouched) when value is out of range or not a whole number for an integer field
+bool setSettingField(void *base, const SettingField &f, float value)
+{
+    if (!(value >= f.min && value <= f.max) || (f.type != FIELD_FLOAT && value != floorf(value)))
+        return false;
+    uint8_t *p = (uint8_t *)base + f.offset;
+    if (f.type == FIELD_FLOAT)
+        *(float *)p = value;
+    else if (f.type == FIELD_UINT)
+        *(unsigned int *)p = (unsigned int)value;
+    else
+        *(bool *)p = value != 0;
+    return true;
+}
+
+// True if every field of base (Settings, or SupplySettings when supply) is inside its table range.
+// Bools are checked on the raw byte: an erased or shifted image has 0xFF there.
+bool settingFieldsValid(const void *base, bool supply)
+{
+    for (uint8_t i = 0; i < SETTING_FIELDS; i++)
+    {
+        const SettingField &f = settingFields[i];
+        if (f.supply != supply)
+            continue;
+        float v = f.type == FIELD_BOOL ? *((const uint8_t *)base + f.offset) : getSettingField(base, f);
+        if (!(v >= f.min && v <= f.max))
+            return false;
+    }
+    return true;
+}
+
+// Rules between fields; returns the offending field, or nullptr when s is consistent
+const char *settingsConflict(const Settings &s)
+{
+    if (s.underVoltage >= s.overVoltage)
+        return "underVoltage";
+    if (s.overCurrent > 0 && s.underCurrent >= s.overCurrent)
+        return "underCurrent";
+    return nullptr;
+}
+
+void publishMeter(uint8_t channel, const PzemFrame *frame);
+void feedWindow(uint8_t motor, float voltage, float current, float pf, uint32_t timestamp);
+const PzemSnapshot &meterFor(uint8_t motor);
+MeterWindow windowFor(uint8_t motor);
+int checkSystemStatus(uint8_t motor);
+void startMotor(uint8_t motor);
+void stopMotor(uint8_t motor, uint8_t reason);
+bool anyMotorRunning();
+float expectedCurrent(uint8_t motor);
+bool fitsSupply(uint8_t motor);
+void requestStart(uint8_t motor);
+void cancelStart(uint8_t motor);
+bool startQueued(uint8_t motor);
+void arbitrate();
+void controlMotor(uint8_t motor, bool isAuto);
+void autoControlTick();
+void journalEvent(uint8_t type, uint8_t motor, int32_t a = 0, int32_t b = 0, int32_t c = 0);
+void journalCheckpoint();
+void recoverRecord(const JournalRecord &r);
+void finishRecovery();
+
+// ---------------- METER ----------------
+// Called by the bus poller for every finished transaction (pzemTask on core 0, or the simulator).
+// A missing reply publishes zeros so a dead meter still trips under-voltage protection.
+void publishMeter(uint8_t channel, const PzemFrame *frame)
+{
+    if (channel >= PZEM_CHANNELS)
+        return;
+    if (!frame)
+        pzemSnapshots[channel].publish(0, 0, 0, 0, 0, io.now(), false);
+    else
+        pzemSnapshots[channel].publish(frame->voltage, frame->current, frame->power, frame->energy, frame->pf, frame->timestamp);
+
+    for (uint8_t m = 0; m < MOTOR_COUNT; m++)
+    {
+        if (motorPins[m].meter != channel)
+            continue;
+        if (frame)
+            feedWindow(m, frame->voltage, frame->current, frame->pf, frame->timestamp);
+        else
+            feedWindow(m, 0, 0, 0, io.now());
+    }
+}
+
+// Window length follows Settings::tripWindow; a start or stop begins a fresh window so the
+// idle samples never mix with the running ones
+void feedWindow(uint8_t motor, float voltage, float current, float pf, uint32_t timestamp)
+{
+    MotorWindow &w = motorWindows[motor];
+    const Settings &s = motors[motor].settings;
+    bool running = motors[motor].running;
+    unsigned int seconds = s.tripWindow > TRIP_WINDOW_MAX ? TRIP_WINDOW_MAX : s.tripWindow;
+    uint16_t length = seconds * 1000UL / PZEM_POLL_INTERVAL_MS;
+    if (length < 1)
+        length = 1;
+
+    if (running != w.running || length != w.voltage.length())
+    {
+        w.voltage.reset(length);
+        w.current.reset(length);
+        w.pf.reset(length);
+        w.running = running;
+    }
+    w.voltage.push(voltage);
+    w.current.push(current);
+    w.pf.push(pf);
+
+    windowStats[motor].publish({timestamp, w.voltage.stats(), w.current.stats(), w.pf.stats()});
+}
+
+const PzemSnapshot &meterFor(uint8_t motor)
+{
+    return pzemSnapshots[motorPins[motor].meter];
+}
+
+MeterWindow windowFor(uint8_t motor)
+{
+    return windowStats[motor].read();
+}
+
+// ---------------- CHECK SYSTEM ----------------
+// Return codes: 0=OK, 1=OHT Low (should run), 2=UGT low, 3=OV/UV, 4=OC, 5=UC, 6=Dry run
+int checkSystemStatus(uint8_t motor)
+{
+    const char *errorMsg = nullptr;
+    MotorChannel &m = motors[motor];
+    const MotorPins &pins = motorPins[motor];
+    const Settings &s = m.settings;
+
+    int errorCode = 0;
+    for (uint8_t k = 0; k < MOTOR_COUNT; k++)
+    {
+        if (motors[k].error < 4)
+            continue;
+        if (io.now() - m.lastErrorTime < 60 * /*60 */ 2 * 1000UL) // for 2 minute dont cheack errors again
+        {
+            return m.error;
+        }
+        break;
+    }
+
+    // One consistent set of window statistics per decision
+    const MeterWindow window = windowFor(motor);
+    const WindowStats &voltage = window.voltage, &current = window.current, &pf = window.pf;
+    const uint32_t floats = floatInputs.levels();
+
+    // --- Motor stabilization delay ---
+    //  If motor just turned on, set stabilization timer
+    if (m.running && m.stabilizationStart == 0)
+    {
+        m.stabilizationStart = io.now();
+    }
+    if (!m.running)
+    {
+        m.stabilizationStart = 0; // reset when motor off
+    }
+    // Wait until after stabilization delay before current/PF checks
+    bool stabilized = !m.running || (io.now() - m.stabilizationStart >= stabilizationDelay * 1000UL);
+
+    if ((voltage.mean < s.underVoltage || voltage.mean > s.overVoltage) && s.detectVoltage)
+    {
+        errorMsg = (voltage.mean < s.underVoltage) ? "LOW Voltage" : "HIGH Voltage";
+        errorCode = 3;
+    }
+    else if (m.running && current.mean > s.overCurrent && s.detectCurrent && stabilized)
+    {
+        errorMsg = "Over current";
+        errorCode = 4;
+    }
+    else if (m.running && current.max < s.underCurrent && s.detectCurrent && stabilized)
+    {
+        errorMsg = "Under current";
+        errorCode = 5;
+    }
+    else if (m.running && current.max < s.underCurrent && pf.max < s.minPF && s.dryRun && stabilized)
+    {
+        errorMsg = "Dry run";
+        errorCode = 6;
+    }
+    else if (pins.sourcePin != NO_FLOAT && !(floats & (1UL << pins.sourcePin)))
+    {
+        errorMsg = "UGT empty";
+        errorCode = 2;
+    }
+    else if (!(floats & (1UL << pins.ohtPin)))
+    {
+        errorMsg = "OHT LOW";
+        errorCode = 1;
+    }
+
+    m.lastErrorTime = io.now();
+    if (errorCode >= 2 && errorCode != m.error)
+        journalEvent(EV_FAULT, motor, errorCode, lroundf(voltage.mean * 10), lroundf(current.mean * 1000));
+    if (errorMsg)
+    {
+        strncpy(m.errorMessage, errorMsg, sizeof(m.errorMessage) - 1);
+        m.errorMessage[sizeof(m.errorMessage) - 1] = '\0';
+        return errorCode;
+    }
+
+    // No error
+    strncpy(m.errorMessage, "OK", sizeof(m.errorMessage) - 1);
+    m.errorMessage[sizeof(m.errorMessage) - 1] = '\0';
+    return 0;
+}
+
+// ---------------- MOTOR HELPERS ----------------
+void startMotor(uint8_t motor)
+{
+    MotorChannel &m = motors[motor];
+
+    if (!m.running)
+    {
+        io.writePin(motorPins[motor].relayPin, HIGH);
+        m.running = true;
+        m.lastOnTime = io.now();
+        io.log("%s Motor turned ON\n", motorPins[motor].name);
+        journalEvent(EV_START, motor, powerFailed);
+    }
+}
+
+// reason: a StopReason, recorded with the run
+void stopMotor(uint8_t motor, uint8_t reason)
+{
+    MotorChannel &m = motors[motor];
+
+    if (m.running)
+    {
+        io.writePin(motorPins[motor].relayPin, LOW);
+        m.running = false;
+        m.lastOffTime = io.now();
+        io.log("%s Motor turned OFF\n", motorPins[motor].name);
+        journalEvent(EV_STOP, motor, reason, (int32_t)(m.lastOffTime - m.lastOnTime));
+        // Freed supply may let a queued motor start
+        arbitrate();
+    }
+}
+
+bool anyMotorRunning()
+{
+    for (uint8_t k = 0; k < MOTOR_COUNT; k++)
+        if (motors[k].running)
+            return true;
+    return false;
+}
+
+// Current a motor adds to the supply: calibrateMotor() sets overCurrent to 120% of the running
+// current, so that is the estimate before a motor starts; a running motor's own meter may show more.
+float expectedCurrent(uint8_t motor)
+{
+    float nominal = motors[motor].settings.overCurrent / 1.2f;
+#ifndef PZEM_SHARED_METER
+    if (motors[motor].running)
+    {
+        MeterWindow w = windowFor(motor);
+        if (w.current.count && w.current.mean > nominal)
+            return w.current.mean;
+    }
+#endif
+    return nominal;
+}
+
+bool fitsSupply(uint8_t motor)
+{
+    if (supplySettings.currentBudget <= 0)
+        return !anyMotorRunning();
+
+    float total = expectedCurrent(motor);
+    for (uint8_t k = 0; k < MOTOR_COUNT; k++)
+        if (motors[k].running)
+            total += expectedCurrent(k);
+    return total <= supplySettings.currentBudget;
+}
+
+// Queue a start; a motor already queued keeps its place (and its age)
+void requestStart(uint8_t motor)
+{
+    if (!motors[motor].running)
+        startQueue.push(motor, motor, io.now(), supplySettings.agingMinutes * 60000UL);
+}
+
+void cancelStart(uint8_t motor)
+{
+    startQueue.remove(motor);
+}
+
+bool startQueued(uint8_t motor)
+{
+    return startQueue.contains(motor);
+}
+
+// Start queued motors in order. The head blocks everything behind it until it fits, so a big pump is
+// never overtaken forever by small ones. Starts are stabilizationDelay apart so inrush never overlaps.
+void arbitrate()
+{
+    while (const StartQueue<MOTOR_COUNT>::Entry *head = startQueue.top())
+    {
+        uint8_t k = head->motor;
+        MotorChannel &m = motors[k];
+
+        if (!m.running)
+        {
+            m.error = checkSystemStatus(k);
+            if (m.error == 1)
+            {
+                if (!fitsSupply(k))
+                    return;
+                if (anyMotorRunning() && io.now() - lastGrantTime < (unsigned long)stabilizationDelay * 1000UL)
+                    return;
+                io.log("Starting %s (queued %lu s)\n", motorPins[k].name, (unsigned long)((io.now() - head->queued) / 1000));
+                startQueue.pop();
+                startMotor(k);
+                lastGrantTime = io.now();
+                powerFailed = 0; // clear power-failed flag after the first start
+                continue;
+            }
+            // Tank full or a fault: the request is stale
+            io.log("%s start request dropped (%s)\n", motorPins[k].name, m.error == 0 ? "tank full" : m.errorMessage);
+        }
+        startQueue.pop();
+    }
+}
+
+// ---------------- MOTOR CONTROL (auto/manual) ----------------
+void controlMotor(uint8_t motor, bool isAuto)
+{
+    MotorChannel &m = motors[motor];
+    Settings &s = m.settings;
+
+    m.error = checkSystemStatus(motor);
+
+    // If motor is OFF: see if we can start
+    if (!m.running)
+    {
+        // Determine readiness (power failure overrides timer)
+        bool readyToStart = (powerFailed || (s.cyclicTimer ? (io.now() - m.lastOffTime >= (unsigned long)s.offTime * 60000UL) : true)) && (m.error == 1);
+
+        // AUTO: a ready motor queues a start request, arbitrate() decides when it runs.
+        // Manual starts are queued by the button handlers instead.
+        if (isAuto)
+        {
+            if (readyToStart)
+                requestStart(motor);
+            else
+                cancelStart(motor);
+        }
+    }
+    else
+    {
+        // Motor is ON: check stop conditions
+        if (s.onTime < 1)
+            s.onTime = 1;
+
+        bool stopCondition = (m.error == 0 || m.error >= 2);
+
+        if (!isAuto)
+        {
+            // In manual mode, we stop if user toggles off (handled elsewhere) or conditions require stop
+            if (stopCondition)
+            {
+                stopMotor(motor, m.error == 0 ? STOP_TANK_FULL : m.error);
+            }
+        }
+        else
+        {
+            // Auto mode: stop on error or after onTime if cyclicTimer enabled
+            if (stopCondition)
+            {
+                stopMotor(motor, m.error == 0 ? STOP_TANK_FULL : m.error);
+            }
+            else if (s.cyclicTimer && (io.now() - m.lastOnTime >= (unsigned long)s.onTime * 60000UL))
+            {
+                stopMotor(motor, STOP_TIMER);
+            }
+        }
+    }
+}
+
+// AUTO switch position: wait for power-on delay, then every motor in priority order
+void autoControlTick()
+{
+    if ((io.now() / 1000) > boreSettings.PowerOnDelay)
+    {
+        for (uint8_t k = 0; k < MOTOR_COUNT; k++)
+            controlMotor(k, true);
+        arbitrate();
+    }
+}
+
+// ---------------- JOURNAL ----------------
+void journalEvent(uint8_t type, uint8_t motor, int32_t a, int32_t b, int32_t c)
+{
+    if (!io.journal)
+        return;
+    JournalRecord r = {};
+    r.uptime = io.now();
+    r.type = type;
+    r.motor = motor;
+    r.a = a;
+    r.b = b;
+    r.c = c;
+    io.journal(r);
+}
+
+// Everything recovery needs, written at the start of every journal sector
+void journalCheckpoint()
+{
+    journalEvent(EV_SYSTEM, 0, powerFailed);
+    for (uint8_t k = 0; k < MOTOR_COUNT; k++)
+    {
+        const MotorChannel &m = motors[k];
+        uint32_t offFor = io.now() - m.lastOffTime;
+        bool stopped = !m.running && m.lastOffTime;
+        journalEvent(EV_STATE, k, m.running, stopped ? (int32_t)(offFor > 0x7FFFFFFF ? 0x7FFFFFFF : offFor) : -1, m.error);
+    }
+}
+
+// Boot recovery: replay the journal on a virtual clock that treats every outage as zero length
+// (there is no clock running while the power is off), so a motor that stopped 10 min before the
+// last record still owes offTime - 10 min. A motor that was running when the power went, or an
+// empty journal, leaves powerFailed set and the motors start as soon as PowerOnDelay has passed.
+struct JournalRecovery
+{
+    bool seen = false;
+    bool powerFailed = true;
+    uint32_t sessionBase = 0; // virtual ms at uptime 0 of the current boot
+    uint32_t end = 0;         // virtual ms of the newest record
+    bool running[MOTOR_COUNT] = {};
+    bool stopped[MOTOR_COUNT] = {};
+    uint32_t offAt[MOTOR_COUNT] = {};
+};
+
+JournalRecovery recovery;
+
+void recoverRecord(const JournalRecord &r)
+{
+    if (r.type == EV_BOOT)
+        recovery.sessionBase = recovery.end - r.uptime;
+    recovery.end = recovery.sessionBase + r.uptime;
+    recovery.seen = true;
+    if (r.motor >= MOTOR_COUNT)
+        return;
+
+    switch (r.type)
+    {
+    case EV_START:
+        recovery.running[r.motor] = true;
+        recovery.powerFailed = false;
+        break;
+    case EV_STOP:
+        recovery.running[r.motor] = false;
+        recovery.stopped[r.motor] = true;
+        recovery.offAt[r.motor] = recovery.end;
+        break;
+    case EV_STATE:
+        recovery.running[r.motor] = r.a;
+        recovery.stopped[r.motor] = !r.a && r.b >= 0;
+        recovery.offAt[r.motor] = recovery.end - (uint32_t)r.b;
+        break;
+    case EV_SYSTEM:
+        recovery.powerFailed = r.a;
+        break;
+    }
+}
+
+void finishRecovery()
+{
+    bool wasRunning = false;
+    for (uint8_t k = 0; k < MOTOR_COUNT; k++)
+    {
+        wasRunning |= recovery.running[k];
+        if (recovery.stopped[k] && !recovery.running[k])
+            motors[k].lastOffTime = io.now() - (recovery.end - recovery.offAt[k]);
+    }
+    powerFailed = !recovery.seen || wasRunning || recovery.powerFailed;
+    io.log("Journal recovery: %s, powerFailed=%d\n", recovery.seen ? "restored" : "empty", powerFailed);
+}
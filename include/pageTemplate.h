@@ -0,0 +1,185 @@
+// pageTemplate.h — HTML template compiled once into literal ranges and placeholder ids
+// compile() scans the text for %NAME% where NAME is in the caller's name table and records a
+// segment list; anything else between percent signs (CSS widths, "50%") stays literal. render()
+// then copies literal bytes straight out of the cached text and asks the caller to format only the
+// placeholders, through one fixed chunk buffer: no String, no heap, no rescanning per request.
+#pragma once
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TEMPLATE_LITERAL 0xFF // segment field id for literal bytes
+#define TEMPLATE_NAME_MAX 24  // longest placeholder name considered
+
+struct TemplateSegment
+{
+    uint32_t offset; // into the cached text (literal segments)
+    uint16_t length;
+    uint8_t field; // placeholder id, or TEMPLATE_LITERAL
+};
+
+// Collects output into N byte chunks and hands each full chunk to sink(const char *, size_t)
+template <size_t N, class Sink>
+class ChunkWriter
+{
+public:
+    explicit ChunkWriter(Sink sink) : _sink(sink) {}
+
+    void write(const char *data, size_t len)
+    {
+        if (len >= N)
+        {
+            // Big literal: no point copying it through the buffer
+            flush();
+            _sink(data, len);
+            return;
+        }
+        if (_used + len > N)
+            flush();
+        memcpy(_buf + _used, data, len);
+        _used += len;
+    }
+
+    void flush()
+    {
+        if (_used)
+            _sink(_buf, _used);
+        _used = 0;
+    }
+
+private:
+    Sink _sink;
+    char _buf[N];
+    size_t _used = 0;
+};
+
+template <uint16_t MAX_SEGMENTS>
+class PageTemplate
+{
+public:
+    ~PageTemplate()
+    {
+        free(_text);
+    }
+
+    // Storage for the raw template (kept between compiles, grown only when a bigger file arrives)
+    char *buffer(size_t len)
+    {
+        if (len > _capacity)
+        {
+            char *p = (char *)realloc(_text, len);
+            if (!p)
+                return nullptr;
+            _text = p;
+            _capacity = len;
+        }
+        _length = len;
+        _segments = 0;
+        return _text;
+    }
+
+    // Build the segment table from the len bytes in buffer(); names[i] is the placeholder for id i
+    bool compile(const char *const *names, uint8_t nameCount)
+    {
+        _segments = 0;
+        uint32_t literal = 0; // start of the pending literal run
+        uint32_t i = 0;
+        while (i < _length)
+        {
+            uint8_t field;
+            uint32_t end;
+            if (_text[i] != '%' || !matchName(i + 1, names, nameCount, field, end))
+            {
+                i++;
+                continue;
+            }
+            if (!addLiteral(literal, i) || _segments >= MAX_SEGMENTS)
+                return fail();
+            _segment[_segments++] = {i, 0, field};
+            i = end + 1; // past the closing '%'
+            literal = i;
+        }
+        if (!addLiteral(literal, _length))
+            return fail();
+        return true;
+    }
+
+    bool ready() const
+    {
+        return _segments > 0;
+    }
+
+    uint16_t segments() const
+    {
+        return _segments;
+    }
+
+    size_t size() const
+    {
+        return _length;
+    }
+
+    // format(field, out, cap) writes at most cap - 1 chars for one placeholder and returns the count
+    template <class Writer, class Format>
+    void render(Writer &out, Format format) const
+    {
+        char scratch[64];
+        for (uint16_t s = 0; s < _segments; s++)
+        {
+            const TemplateSegment &seg = _segment[s];
+            if (seg.field == TEMPLATE_LITERAL)
+            {
+                out.write(_text + seg.offset, seg.length);
+                continue;
+            }
+            size_t n = format(seg.field, scratch, sizeof(scratch));
+            out.write(scratch, n < sizeof(scratch) ? n : sizeof(scratch) - 1);
+        }
+        out.flush();
+    }
+
+private:
+    char *_text = nullptr;
+    size_t _capacity = 0;
+    size_t _length = 0;
+    uint16_t _segments = 0;
+    TemplateSegment _segment[MAX_SEGMENTS];
+
+    bool matchName(uint32_t from, const char *const *names, uint8_t nameCount, uint8_t &field, uint32_t &end) const
+    {
+        uint32_t j = from;
+        while (j < _length && j - from <= TEMPLATE_NAME_MAX && _text[j] != '%')
+            j++;
+        if (j >= _length || _text[j] != '%' || j == from)
+            return false;
+        for (uint8_t k = 0; k < nameCount; k++)
+            if (strlen(names[k]) == j - from && !memcmp(names[k], _text + from, j - from))
+            {
+                field = k;
+                end = j;
+                return true;
+            }
+        return false;
+    }
+
+    // Literal bytes [from, to), split so every piece fits the 16 bit length
+    bool addLiteral(uint32_t from, uint32_t to)
+    {
+        while (from < to)
+        {
+            if (_segments >= MAX_SEGMENTS)
+                return false;
+            uint32_t len = to - from > 0xFFFF ? 0xFFFF : to - from;
+            _segment[_segments++] = {from, (uint16_t)len, TEMPLATE_LITERAL};
+            from += len;
+        }
+        return true;
+    }
+
+    bool fail()
+    {
+        _segments = 0;
+        return false;
+    }
+};
@@ -0,0 +1,124 @@
+// pumpArbiter.h — Priority queue of pump start requests with aging
+// A request's key is (time queued) + priority * agingMs, so every agingMs of waiting is worth one
+// priority level and a low priority pump cannot be starved. The key never changes while queued,
+// so a plain binary heap keeps the order; equal keys fall back to arrival order. Keys are compared
+// as wrapping ms clock values like everything else fed from io.now().
+#pragma once
+
+#include <stdint.h>
+
+template <uint8_t N>
+class StartQueue
+{
+public:
+    struct Entry
+    {
+        uint32_t key;    // lower starts first
+        uint32_t seq;    // arrival order, breaks ties
+        uint32_t queued; // clock value when requested
+        uint8_t motor;
+    };
+
+    StartQueue()
+    {
+        for (uint8_t i = 0; i < N; i++)
+            _pos[i] = NONE;
+    }
+
+    // false if motor is already queued (its place is kept)
+    bool push(uint8_t motor, uint8_t priority, uint32_t now, uint32_t agingMs)
+    {
+        if (motor >= N || _pos[motor] != NONE)
+            return false;
+        uint8_t i = _size++;
+        _heap[i] = {now + priority * agingMs, _seq++, now, motor};
+        _pos[motor] = i;
+        siftUp(i);
+        return true;
+    }
+
+    bool remove(uint8_t motor)
+    {
+        if (motor >= N || _pos[motor] == NONE)
+            return false;
+        uint8_t i = _pos[motor];
+        _pos[motor] = NONE;
+        if (i != --_size)
+        {
+            uint8_t moved = _heap[_size].motor;
+            _heap[i] = _heap[_size];
+            _pos[moved] = i;
+            siftUp(i);
+            siftDown(_pos[moved]);
+        }
+        return true;
+    }
+
+    bool contains(uint8_t motor) const
+    {
+        return motor < N && _pos[motor] != NONE;
+    }
+
+    const Entry *top() const
+    {
+        return _size ? &_heap[0] : nullptr;
+    }
+
+    void pop()
+    {
+        if (_size)
+            remove(_heap[0].motor);
+    }
+
+    uint8_t size() const
+    {
+        return _size;
+    }
+
+private:
+    static const uint8_t NONE = 0xFF;
+    Entry _heap[N];
+    uint8_t _pos[N]; // heap index per motor, NONE if not queued
+    uint8_t _size = 0;
+    uint32_t _seq = 0;
+
+    static bool before(const Entry &a, const Entry &b)
+    {
+        int32_t d = (int32_t)(a.key - b.key);
+        return d != 0 ? d < 0 : (int32_t)(a.seq - b.seq) < 0;
+    }
+
+    void swap(uint8_t a, uint8_t b)
+    {
+        Entry t = _heap[a];
+        _heap[a] = _heap[b];
+        _heap[b] = t;
+        _pos[_heap[a].motor] = a;
+        _pos[_heap[b].motor] = b;
+    }
+
+    void siftUp(uint8_t i)
+    {
+        while (i > 0 && before(_heap[i], _heap[(i - 1) / 2]))
+        {
+            swap(i, (i - 1) / 2);
+            i = (i - 1) / 2;
+        }
+    }
+
+    void siftDown(uint8_t i)
+    {
+        for (;;)
+        {
+            uint8_t l = 2 * i + 1, r = l + 1, best = i;
+            if (l < _size && before(_heap[l], _heap[best]))
+                best = l;
+            if (r < _size && before(_heap[r], _heap[best]))
+                best = r;
+            if (best == i)
+                return;
+            swap(i, best);
+            i = best;
+        }
+    }
+};
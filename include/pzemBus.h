@@ -0,0 +1,140 @@
+// pzemBus.h — Round-robin poller for several PZEM-004T meters sharing one Modbus-RTU UART
+// Non-blocking: poll() is called as often as possible (pzemTask) and never waits on the wire.
+// Each reply is handed to onFrame(channel, frame) the moment its last byte arrives and the next
+// due channel is requested right after the 3.5 character bus gap, so the UART never sits idle
+// while a meter is due.
+#pragma once
+
+#include <stdint.h>
+#include <pzemModbus.h>
+
+// Default: one meter on the bus, polled at the general address, as on every board shipped so far.
+// Build with -D PZEM_METER_PER_MOTOR once each motor has its own meter at the addresses below; a
+// meter leaves the factory at 0x01, so the others have to be re-addressed (pzemSetAddress()) first.
+#ifndef PZEM_METER_PER_MOTOR
+#define PZEM_SHARED_METER
+#endif
+
+#ifndef PZEM_BORE_ADDR
+#define PZEM_BORE_ADDR 0x01
+#endif
+#ifndef PZEM_SUMP_ADDR
+#define PZEM_SUMP_ADDR 0x02
+#endif
+#ifndef PZEM_BORE2_ADDR
+#define PZEM_BORE2_ADDR 0x03
+#endif
+#ifndef PZEM_BOOSTER_ADDR
+#define PZEM_BOOSTER_ADDR 0x04
+#endif
+#define PZEM_FRAME_GAP_MS 4 // Modbus RTU silent interval at 9600 baud (3.5 chars, rounded up)
+
+template <class Port, uint8_t N>
+class PzemPoller
+{
+public:
+    struct ChannelStats
+    {
+        uint32_t frames;   // good replies
+        uint32_t timeouts; // no / short reply
+        uint32_t errors;   // CRC, address or length mismatch
+    };
+
+    // onFrame gets nullptr when the meter did not answer in time
+    PzemPoller(Port &port, const uint8_t (&addresses)[N], void (*onFrame)(uint8_t channel, const PzemFrame *frame),
+               uint32_t intervalMs = PZEM_POLL_INTERVAL_MS)
+        : _port(port), _onFrame(onFrame), _intervalMs(intervalMs)
+    {
+        for (uint8_t i = 0; i < N; i++)
+        {
+            _address[i] = addresses[i];
+            _lastRequest[i] = 0;
+            _stats[i] = {0, 0, 0};
+        }
+    }
+
+    void poll(uint32_t now)
+    {
+        if (_waiting)
+        {
+            while (_got < PZEM_RESPONSE_LEN && _port.available())
+                _resp[_got++] = (uint8_t)_port.read();
+
+            if (_got == PZEM_RESPONSE_LEN)
+                finish(now, true);
+            else if (now - _sentAt >= PZEM_TIMEOUT_MS)
+                finish(now, false);
+            return;
+        }
+
+        if (now - _idleSince < PZEM_FRAME_GAP_MS)
+            return;
+
+        // Round robin from the channel after the last one served, first one that is due wins
+        for (uint8_t k = 1; k <= N; k++)
+        {
+            uint8_t ch = (_current + k) % N;
+            if (_primed[ch] && now - _lastRequest[ch] < _intervalMs)
+                continue;
+            send(ch, now);
+            return;
+        }
+    }
+
+    const ChannelStats &stats(uint8_t channel) const
+    {
+        return _stats[channel];
+    }
+
+private:
+    Port &_port;
+    void (*_onFrame)(uint8_t channel, const PzemFrame *frame);
+    uint32_t _intervalMs;
+    uint8_t _address[N];
+    uint32_t _lastRequest[N];
+    bool _primed[N] = {};
+    ChannelStats _stats[N];
+
+    uint8_t _current = N - 1;
+    bool _waiting = false;
+    uint32_t _sentAt = 0;
+    uint32_t _idleSince = 0;
+    uint8_t _resp[PZEM_RESPONSE_LEN];
+    uint8_t _got = 0;
+
+    void send(uint8_t ch, uint32_t now)
+    {
+        uint8_t req[PZEM_REQUEST_LEN];
+        while (_port.available()) // late bytes from a timed-out meter
+            _port.read();
+        _port.write(req, pzemBuildReadAll(_address[ch], req));
+        _current = ch;
+        _lastRequest[ch] = now;
+        _primed[ch] = true;
+        _sentAt = now;
+        _got = 0;
+        _waiting = true;
+    }
+
+    void finish(uint32_t now, bool complete)
+    {
+        PzemFrame frame;
+        _waiting = false;
+        _idleSince = now;
+        if (!complete)
+        {
+            _stats[_current].timeouts++;
+            _onFrame(_current, nullptr);
+            return;
+        }
+        if (!pzemParseReadAll(_resp, _got, _address[_current], frame))
+        {
+            _stats[_current].errors++;
+            _onFrame(_current, nullptr);
+            return;
+        }
+        frame.timestamp = now;
+        _stats[_current].frames++;
+        _onFrame(_current, &frame);
+    }
+};
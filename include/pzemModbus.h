@@ -0,0 +1,170 @@
+// pzemModbus.h — Single-transaction Modbus-RTU read of the whole PZEM-004T v3 input register block
+// One 8 byte request returns V, I, P, E, Hz, PF and the alarm flag in a 25 byte reply, instead of one
+// round trip per quantity. Port is anything with write(buf,len)/available()/read() (HardwareSerial,
+// or the fake device in the host simulator).
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#define PZEM_GENERAL_ADDR 0xF8      // every PZEM answers this address (single meter on the bus)
+#define PZEM_CMD_READ_INPUT 0x04    // read input registers
+#define PZEM_CMD_WRITE_SINGLE 0x06  // write holding register
+#define PZEM_REG_SLAVE_ADDR 0x0002  // holding register with the Modbus address (0x01..0xF7)
+#define PZEM_REG_COUNT 10           // 0x0000..0x0009
+#define PZEM_REQUEST_LEN 8
+#define PZEM_RESPONSE_LEN (5 + 2 * PZEM_REG_COUNT) // addr, cmd, count, data, crc16
+#define PZEM_TIMEOUT_MS 100
+#define PZEM_POLL_INTERVAL_MS 200 // meter refreshes its registers at ~5 Hz
+
+struct PzemFrame
+{
+    uint32_t timestamp; // clock value when the reply completed
+    float voltage;      // V
+    float current;      // A
+    float power;        // W
+    float energy;       // kWh
+    float frequency;    // Hz
+    float pf;
+    bool alarm; // power alarm threshold exceeded
+};
+
+// CRC-16/MODBUS (poly 0xA001 reflected, init 0xFFFF), one table lookup per byte
+static const uint16_t pzemCrcTable[256] = {
+    0x0000, 0xC0C1, 0xC181, 0x0140, 0xC301, 0x03C0, 0x0280, 0xC241, 0xC601, 0x06C0, 0x0780, 0xC741, 0x0500, 0xC5C1, 0xC481, 0x0440,
+    0xCC01, 0x0CC0, 0x0D80, 0xCD41, 0x0F00, 0xCFC1, 0xCE81, 0x0E40, 0x0A00, 0xCAC1, 0xCB81, 0x0B40, 0xC901, 0x09C0, 0x0880, 0xC841,
+    0xD801, 0x18C0, 0x1980, 0xD941, 0x1B00, 0xDBC1, 0xDA81, 0x1A40, 0x1E00, 0xDEC1, 0xDF81, 0x1F40, 0xDD01, 0x1DC0, 0x1C80, 0xDC41,
+    0x1400, 0xD4C1, 0xD581, 0x1540, 0xD701, 0x17C0, 0x1680, 0xD641, 0xD201, 0x12C0, 0x1380, 0xD341, 0x1100, 0xD1C1, 0xD081, 0x1040,
+    0xF001, 0x30C0, 0x3180, 0xF141, 0x3300, 0xF3C1, 0xF281, 0x3240, 0x3600, 0xF6C1, 0xF781, 0x3740, 0xF501, 0x35C0, 0x3480, 0xF441,
+    0x3C00, 0xFCC1, 0xFD81, 0x3D40, 0xFF01, 0x3FC0, 0x3E80, 0xFE41, 0xFA01, 0x3AC0, 0x3B80, 0xFB41, 0x3900, 0xF9C1, 0xF881, 0x3840,
+    0x2800, 0xE8C1, 0xE981, 0x2940, 0xEB01, 0x2BC0, 0x2A80, 0xEA41, 0xEE01, 0x2EC0, 0x2F80, 0xEF41, 0x2D00, 0xEDC1, 0xEC81, 0x2C40,
+    0xE401, 0x24C0, 0x2580, 0xE541, 0x2700, 0xE7C1, 0xE681, 0x2640, 0x2200, 0xE2C1, 0xE381, 0x2340, 0xE101, 0x21C0, 0x2080, 0xE041,
+    0xA001, 0x60C0, 0x6180, 0xA141, 0x6300, 0xA3C1, 0xA281, 0x6240, 0x6600, 0xA6C1, 0xA781, 0x6740, 0xA501, 0x65C0, 0x6480, 0xA441,
+    0x6C00, 0xACC1, 0xAD81, 0x6D40, 0xAF01, 0x6FC0, 0x6E80, 0xAE41, 0xAA01, 0x6AC0, 0x6B80, 0xAB41, 0x6900, 0xA9C1, 0xA881, 0x6840,
+    0x7800, 0xB8C1, 0xB981, 0x7940, 0xBB01, 0x7BC0, 0x7A80, 0xBA41, 0xBE01, 0x7EC0, 0x7F80, 0xBF41, 0x7D00, 0xBDC1, 0xBC81, 0x7C40,
+    0xB401, 0x74C0, 0x7580, 0xB541, 0x7700, 0xB7C1, 0xB681, 0x7640, 0x7200, 0xB2C1, 0xB381, 0x7340, 0xB101, 0x71C0, 0x7080, 0xB041,
+    0x5000, 0x90C1, 0x9181, 0x5140, 0x9301, 0x53C0, 0x5280, 0x9241, 0x9601, 0x56C0, 0x5780, 0x9741, 0x5500, 0x95C1, 0x9481, 0x5440,
+    0x9C01, 0x5CC0, 0x5D80, 0x9D41, 0x5F00, 0x9FC1, 0x9E81, 0x5E40, 0x5A00, 0x9AC1, 0x9B81, 0x5B40, 0x9901, 0x59C0, 0x5880, 0x9841,
+    0x8801, 0x48C0, 0x4980, 0x8941, 0x4B00, 0x8BC1, 0x8A81, 0x4A40, 0x4E00, 0x8EC1, 0x8F81, 0x4F40, 0x8D01, 0x4DC0, 0x4C80, 0x8C41,
+    0x4400, 0x84C1, 0x8581, 0x4540, 0x8701, 0x47C0, 0x4680, 0x8641, 0x8201, 0x42C0, 0x4380, 0x8341, 0x4100, 0x81C1, 0x8081, 0x4040};
+
+inline uint16_t pzemCrc16(const uint8_t *data, size_t len)
+{
+    uint16_t crc = 0xFFFF;
+    while (len--)
+        crc = (crc >> 8) ^ pzemCrcTable[(crc ^ *data++) & 0xFF];
+    return crc;
+}
+
+// Request for registers 0x0000..0x0009 — always PZEM_REQUEST_LEN bytes
+inline size_t pzemBuildReadAll(uint8_t addr, uint8_t *out)
+{
+    out[0] = addr;
+    out[1] = PZEM_CMD_READ_INPUT;
+    out[2] = 0x00; // start register hi
+    out[3] = 0x00; // start register lo
+    out[4] = 0x00; // count hi
+    out[5] = PZEM_REG_COUNT;
+    uint16_t crc = pzemCrc16(out, 6);
+    out[6] = crc & 0xFF;
+    out[7] = crc >> 8;
+    return PZEM_REQUEST_LEN;
+}
+
+// Decode a complete reply; false on wrong address/function/length or CRC mismatch
+inline bool pzemParseReadAll(const uint8_t *buf, size_t len, uint8_t addr, PzemFrame &out)
+{
+    if (len != PZEM_RESPONSE_LEN || buf[1] != PZEM_CMD_READ_INPUT || buf[2] != 2 * PZEM_REG_COUNT)
+        return false;
+    if (addr != PZEM_GENERAL_ADDR && buf[0] != addr)
+        return false;
+    uint16_t crc = pzemCrc16(buf, len - 2);
+    if (buf[len - 2] != (crc & 0xFF) || buf[len - 1] != (crc >> 8))
+        return false;
+
+    const uint8_t *r = buf + 3;
+    auto reg = [r](int i) -> uint32_t
+    { return ((uint32_t)r[2 * i] << 8) | r[2 * i + 1]; };
+    auto reg32 = [&reg](int lo) -> uint32_t // 32 bit values are sent low word first
+    { return reg(lo) | (reg(lo + 1) << 16); };
+
+    out.voltage = reg(0) / 10.0f;
+    out.current = reg32(1) / 1000.0f;
+    out.power = reg32(3) / 10.0f;
+    out.energy = reg32(5) / 1000.0f;
+    out.frequency = reg(7) / 10.0f;
+    out.pf = reg(8) / 100.0f;
+    out.alarm = reg(9) != 0;
+    return true;
+}
+
+// Blocking request/reply with timeout. wait() (optional) is called while the reply is in flight,
+// e.g. to yield the FreeRTOS task for a tick.
+template <class Port>
+bool pzemReadAll(Port &port, uint8_t addr, PzemFrame &out, uint32_t (*now)(), void (*wait)() = nullptr,
+                 uint32_t timeoutMs = PZEM_TIMEOUT_MS)
+{
+    uint8_t req[PZEM_REQUEST_LEN];
+    uint8_t resp[PZEM_RESPONSE_LEN];
+    size_t got = 0;
+
+    while (port.available()) // drop anything left over from a timed-out transaction
+        port.read();
+    port.write(req, pzemBuildReadAll(addr, req));
+
+    uint32_t start = now();
+    while (got < PZEM_RESPONSE_LEN)
+    {
+        if (port.available())
+        {
+            resp[got++] = (uint8_t)port.read();
+            continue;
+        }
+        if (now() - start >= timeoutMs)
+            return false;
+        if (wait)
+            wait();
+    }
+
+    if (!pzemParseReadAll(resp, got, addr, out))
+        return false;
+    out.timestamp = now();
+    return true;
+}
+
+// Commissioning: give the only meter on the bus a new Modbus address (0x01..0xF7) so several meters
+// can share Serial2. The meter echoes the request on success. The firmware does not call this; it is
+// for a bench sketch run with one meter connected, before building with -D PZEM_METER_PER_MOTOR.
+template <class Port>
+bool pzemSetAddress(Port &port, uint8_t newAddr, uint32_t (*now)(), void (*wait)() = nullptr,
+                    uint32_t timeoutMs = PZEM_TIMEOUT_MS)
+{
+    uint8_t req[8] = {PZEM_GENERAL_ADDR, PZEM_CMD_WRITE_SINGLE, PZEM_REG_SLAVE_ADDR >> 8, PZEM_REG_SLAVE_ADDR & 0xFF, 0x00, newAddr};
+    uint8_t resp[8];
+    size_t got = 0;
+    if (newAddr < 0x01 || newAddr > 0xF7)
+        return false;
+    uint16_t crc = pzemCrc16(req, 6);
+    req[6] = crc & 0xFF;
+    req[7] = crc >> 8;
+
+    while (port.available())
+        port.read();
+    port.write(req, sizeof(req));
+
+    uint32_t start = now();
+    while (got < sizeof(resp))
+    {
+        if (port.available())
+        {
+            resp[got++] = (uint8_t)port.read();
+            continue;
+        }
+        if (now() - start >= timeoutMs)
+            return false;
+        if (wait)
+            wait();
+    }
+    return memcmp(req + 1, resp + 1, sizeof(req) - 1) == 0;
+}
@@ -0,0 +1,122 @@
+// pzemSnapshot.h — Torn-read-free PZEM data shared between pzemTask (core 0) and readers (core 1)
+// Single writer seqlock: the sequence is odd while a publish is in progress, readers retry until
+// they see the same even sequence before and after copying the fields. No locks, no allocation.
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include <type_traits>
+
+// Any trivially copyable T, stored as relaxed atomic words so a torn copy is never undefined behaviour
+template <class T>
+class Seqlock
+{
+    static_assert(std::is_trivially_copyable<T>::value, "Seqlock needs a trivially copyable type");
+    static const size_t WORDS = (sizeof(T) + 3) / 4;
+
+public:
+    Seqlock()
+    {
+        for (size_t i = 0; i < WORDS; i++)
+            _words[i].store(0, std::memory_order_relaxed);
+    }
+
+    // Writer side — only one task may publish
+    void publish(const T &value)
+    {
+        uint32_t w[WORDS] = {};
+        memcpy(w, &value, sizeof(T));
+
+        uint32_t s = _seq.load(std::memory_order_relaxed);
+        _seq.store(s + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        for (size_t i = 0; i < WORDS; i++)
+            _words[i].store(w[i], std::memory_order_relaxed);
+
+        _seq.store(s + 2, std::memory_order_release);
+    }
+
+    // One attempt; false if a publish overlapped the copy. seq gets the publish count.
+    bool tryRead(T &out, uint32_t *seq = nullptr) const
+    {
+        uint32_t w[WORDS];
+        uint32_t s1 = _seq.load(std::memory_order_acquire);
+        if (s1 & 1)
+            return false;
+
+        for (size_t i = 0; i < WORDS; i++)
+            w[i] = _words[i].load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (_seq.load(std::memory_order_relaxed) != s1)
+            return false;
+        memcpy(&out, w, sizeof(T));
+        if (seq)
+            *seq = s1 / 2;
+        return true;
+    }
+
+    // Consistent copy; the writer holds the odd sequence for a handful of stores only
+    T read(uint32_t *seq = nullptr) const
+    {
+        T value;
+        while (!tryRead(value, seq))
+        {
+        }
+        return value;
+    }
+
+    uint32_t sequence() const
+    {
+        return _seq.load(std::memory_order_acquire) / 2;
+    }
+
+private:
+    std::atomic<uint32_t> _seq{0};
+    std::atomic<uint32_t> _words[WORDS];
+};
+
+struct PzemReading
+{
+    uint32_t seq;       // publish count (0 = nothing published yet)
+    uint32_t timestamp; // io.now() when the sample was taken
+    float voltage;
+    float current;
+    float power;
+    float energy;
+    float pf;
+    bool valid; // false: the poll failed and every reading is 0 (energy is not the meter's register)
+};
+
+class PzemSnapshot
+{
+public:
+    void publish(float v, float i, float p, float e, float powerFactor, uint32_t timestamp, bool valid = true)
+    {
+        _cell.publish({0, timestamp, v, i, p, e, powerFactor, valid});
+    }
+
+    bool tryRead(PzemReading &out) const
+    {
+        return _cell.tryRead(out, &out.seq);
+    }
+
+    PzemReading read() const
+    {
+        PzemReading r;
+        while (!tryRead(r))
+        {
+        }
+        return r;
+    }
+
+    uint32_t sequence() const
+    {
+        return _cell.sequence();
+    }
+
+private:
+    Seqlock<PzemReading> _cell;
+};
@@ -0,0 +1,130 @@
+// pzemStats.h — Sliding window statistics over the most recent meter samples
+// Mean, RMS deviation and least-squares slope come from running sums, min/max from monotonic
+// deques of sample indices, so push() is O(1) (amortised) and nothing is allocated. The running
+// sums are rebuilt from the ring once per window so rounding errors cannot pile up over months.
+#pragma once
+
+#include <stdint.h>
+#include <math.h>
+
+struct WindowStats
+{
+    uint16_t count; // samples in the window (0 = nothing seen since reset)
+    float mean;
+    float min;
+    float max;
+    float rms;   // RMS deviation from the mean
+    float slope; // least-squares trend, units per sample
+};
+
+template <uint16_t N>
+class RollingWindow
+{
+    static_assert(N && (N & (N - 1)) == 0, "window capacity must be a power of two (index wrap)");
+
+public:
+    RollingWindow()
+    {
+        reset(N);
+    }
+
+    // Empty the window and set how many samples (1..N) it spans
+    void reset(uint16_t length)
+    {
+        _length = length < 1 ? 1 : length > N ? N
+                                               : length;
+        _count = 0;
+        _next = 0;
+        _sinceRebuild = 0;
+        _sum = _sumSq = _sumKx = 0;
+        _minHead = _minTail = _maxHead = _maxTail = 0;
+    }
+
+    uint16_t length() const
+    {
+        return _length;
+    }
+
+    void push(float x)
+    {
+        uint32_t idx = _next++;
+
+        if (_count == _length)
+        {
+            // Drop the oldest sample; every remaining sample moves one position towards 0
+            uint32_t oldest = idx - _length;
+            double y0 = _ring[oldest % N];
+            _sum -= y0;
+            _sumSq -= y0 * y0;
+            _sumKx -= _sum;
+            _count--;
+            if (_minHead != _minTail && _minIdx[_minHead % N] == oldest)
+                _minHead++;
+            if (_maxHead != _maxTail && _maxIdx[_maxHead % N] == oldest)
+                _maxHead++;
+        }
+
+        _ring[idx % N] = x;
+        _sumKx += (double)_count * x;
+        _sum += x;
+        _sumSq += (double)x * x;
+        _count++;
+
+        while (_minHead != _minTail && _ring[_minIdx[(_minTail - 1) % N] % N] >= x)
+            _minTail--;
+        _minIdx[_minTail++ % N] = idx;
+        while (_maxHead != _maxTail && _ring[_maxIdx[(_maxTail - 1) % N] % N] <= x)
+            _maxTail--;
+        _maxIdx[_maxTail++ % N] = idx;
+
+        if (++_sinceRebuild >= _length)
+            rebuild();
+    }
+
+    WindowStats stats() const
+    {
+        WindowStats st = {_count, 0, 0, 0, 0, 0};
+        if (_count == 0)
+            return st;
+
+        double n = _count;
+        double mean = _sum / n;
+        double var = _sumSq / n - mean * mean;
+        st.mean = (float)mean;
+        st.min = _ring[_minIdx[_minHead % N] % N];
+        st.max = _ring[_maxIdx[_maxHead % N] % N];
+        st.rms = var > 0 ? (float)sqrt(var) : 0;
+        if (_count >= 2)
+        {
+            // Positions 0..n-1: sum k = n(n-1)/2, n*sum k^2 - (sum k)^2 = n^2(n^2-1)/12
+            double sumK = n * (n - 1) / 2;
+            st.slope = (float)((n * _sumKx - sumK * _sum) / (n * n * (n * n - 1) / 12));
+        }
+        return st;
+    }
+
+private:
+    float _ring[N];
+    uint32_t _minIdx[N]; // absolute sample indices, values increasing from head to tail
+    uint32_t _maxIdx[N]; // absolute sample indices, values decreasing from head to tail
+    uint32_t _minHead, _minTail, _maxHead, _maxTail;
+    uint32_t _next; // absolute index of the next sample
+    uint16_t _length;
+    uint16_t _count;
+    uint16_t _sinceRebuild;
+    double _sum, _sumSq, _sumKx; // sum x, sum x^2, sum k*x with k = position in the window
+
+    void rebuild()
+    {
+        _sinceRebuild = 0;
+        _sum = _sumSq = _sumKx = 0;
+        uint32_t first = _next - _count;
+        for (uint16_t k = 0; k < _count; k++)
+        {
+            double x = _ring[(first + k) % N];
+            _sum += x;
+            _sumSq += x * x;
+            _sumKx += k * x;
+        }
+    }
+};
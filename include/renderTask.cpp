@@ -0,0 +1,174 @@
+// ---------------- Render task ----------------
+// From the end of setup() the render task owns tft, tickerSprite and the media player. loop() only
+// says what it wants on screen (displayShow / displayMenu / displayPrompt) through displayQueue;
+// the task drains the queue, keeps the newest request and draws from its own copy of the
+// controller view. A slow SPI transaction or a GIF frame therefore never sits between a fault and
+// stopMotor().
+// The SD card shares the SPI bus with the panel, so both sides take spiBus around it. The render
+// task waits for the bus; loop() only ever tries it and leaves its SD work for a later pass.
+
+#include <displayQueue.h>
+
+enum : uint8_t
+{
+    SCREEN_NONE,
+    SCREEN_STATUS, // status pages, one motor after another
+    SCREEN_MEDIA,  // GIF/JPEG playlist while a motor runs
+    SCREEN_MENU,   // settings menu at arg = menuIndex
+    SCREEN_PROMPT  // two lines of text (calibration, power-on delay)
+};
+
+#define DISPLAY_QUEUE 16
+#define PROMPT_TEXT WIDGET_TEXT
+#define RENDER_IDLE_MS 5 // longest sleep between passes; the ticker steps every 20 ms
+
+struct DisplayCommand
+{
+    uint8_t screen;
+    int16_t arg;
+    char line[2][PROMPT_TEXT];
+};
+
+SpscQueue<DisplayCommand, DISPLAY_QUEUE> displayQueue;
+SemaphoreHandle_t spiBus = nullptr;
+TaskHandle_t renderTaskHandle = nullptr;
+
+// loop() side: the last request, to drop repeats and to retry one the full queue refused
+DisplayCommand displayLast;
+bool displayRetry = false;
+
+bool spiBusTry()
+{
+    return xSemaphoreTake(spiBus, 0) == pdTRUE;
+}
+
+void spiBusGive()
+{
+    xSemaphoreGive(spiBus);
+}
+
+void displayPush(const DisplayCommand &c)
+{
+    displayLast = c;
+    displayRetry = !displayQueue.push(c);
+    if (!displayRetry && renderTaskHandle)
+        xTaskNotifyGive(renderTaskHandle);
+}
+
+// Status pages or media; asking again for the screen already requested queues nothing
+void displayShow(uint8_t screen)
+{
+    if (screen == displayLast.screen && !displayRetry)
+        return;
+    DisplayCommand c;
+    memset(&c, 0, sizeof(c));
+    c.screen = screen;
+    displayPush(c);
+}
+
+// Every call redraws: the value at menuIndex may have changed
+void displayMenu(int menuIndex)
+{
+    publishControllerView(); // the task draws the settings from the view
+    DisplayCommand c;
+    memset(&c, 0, sizeof(c));
+    c.screen = SCREEN_MENU;
+    c.arg = menuIndex;
+    displayPush(c);
+}
+
+// Countdown loops call this on every pass; only changed text is queued
+void displayPrompt(const char *line1, const char *line2 = "")
+{
+    DisplayCommand c;
+    memset(&c, 0, sizeof(c));
+    c.screen = SCREEN_PROMPT;
+    snprintf(c.line[0], PROMPT_TEXT, "%s", line1);
+    snprintf(c.line[1], PROMPT_TEXT, "%s", line2);
+    if (!displayRetry && !memcmp(&c, &displayLast, sizeof(c)))
+        return;
+    displayPush(c);
+}
+
+// loop(): send again what the full queue refused
+void displayTick()
+{
+    if (displayRetry)
+        displayPush(displayLast);
+}
+
+void renderMedia()
+{
+    static uint32_t nextMediaTry = 0;
+    // The next file starts when the current one ends
+    if (!player.playing() && !mediaFiles.empty() && (int32_t)(millis() - nextMediaTry) >= 0)
+    {
+        const String &fname = mediaFiles[currentFile];
+        currentFile = (currentFile + 1) % mediaFiles.size();
+        if (!player.begin(fname.c_str()))
+            nextMediaTry = millis() + 1000; // unreadable file: try the next one in a second
+    }
+    player.step();
+}
+
+// Redraw every statusRedrawInterval (only changed rows reach the glass), next page every statusInterval
+void renderStatus(bool entered)
+{
+    if (!entered && millis() - lastStatusRedraw < statusRedrawInterval)
+        return;
+    if (millis() - lastStatusChange >= statusInterval)
+    {
+        if (!entered)
+            nextStatusPage();
+        lastStatusChange = millis();
+    }
+    drawStatusScreen(showingMotor);
+    lastStatusRedraw = millis();
+}
+
+void renderTask(void *parameter)
+{
+    DisplayCommand want;
+    memset(&want, 0, sizeof(want));
+    uint8_t shown = SCREEN_NONE;
+    for (;;)
+    {
+        // Coalesce: whatever piled up while the last frame was drawn, only the newest request counts
+        bool changed = false;
+        DisplayCommand c;
+        while (displayQueue.pop(c))
+        {
+            want = c;
+            changed = true;
+        }
+        renderView = controllerView.read();
+
+        xSemaphoreTake(spiBus, portMAX_DELAY);
+        if (want.screen != SCREEN_MEDIA)
+            player.stop();
+        if (changed && (want.screen == SCREEN_PROMPT) != (shown == SCREEN_PROMPT))
+            panel.invalidate(); // prompt lines overlap the rows
+        switch (want.screen)
+        {
+        case SCREEN_STATUS:
+            renderStatus(shown != SCREEN_STATUS);
+            break;
+        case SCREEN_MEDIA:
+            renderMedia();
+            break;
+        case SCREEN_MENU:
+            if (changed)
+                drawMenu(want.arg);
+            break;
+        case SCREEN_PROMPT:
+            if (changed)
+                drawPrompt(want.line[0], want.line[1]);
+            break;
+        }
+        shown = want.screen;
+        updateTicker();
+        xSemaphoreGive(spiBus);
+
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(RENDER_IDLE_MS));
+    }
+}
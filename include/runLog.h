@@ -0,0 +1,76 @@
+// runLog.h — One fixed-size record per pump run, for energy and run history exports
+// main.cpp appends a RunRecord to /runs.bin on the SD card every time a motor stops (built from the
+// journal's EV_START / EV_STOP and the meter's energy register). The binary export is the file
+// itself behind a RunLogHeader, so a PC tool reads it with the same two structs (little endian).
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define RUNLOG_MAGIC 0x524C4357 // "WLCR"
+#define RUNLOG_VERSION 2 // 2: reason is a StopReason (1 was the protection error at stop time)
+
+// Why a motor stopped. Fault codes are checkSystemStatus()'s own, so a fault stop passes its code.
+enum StopReason : uint8_t
+{
+    STOP_OTHER = 0,     // calibration, anything else
+    STOP_TANK_FULL = 1, // OHT float reports full
+    STOP_UGT_EMPTY = 2, // faults 2..6
+    STOP_VOLTAGE = 3,
+    STOP_OVER_CURRENT = 4,
+    STOP_UNDER_CURRENT = 5,
+    STOP_DRY_RUN = 6,
+    STOP_TIMER = 7,  // cyclic ON time used up
+    STOP_MANUAL = 8, // front panel
+    STOP_WEB = 9     // /off
+};
+
+struct RunRecord
+{
+    uint32_t start;      // s, wall clock or the telemetry timeline
+    uint32_t stop;       // s
+    uint32_t durationMs; // relay on time
+    int32_t energyWh;    // energy register difference, or integrated power if the register went back
+    uint32_t avgCurrent; // mA over the run's samples
+    uint32_t samples;    // meter samples averaged
+    uint8_t motor;
+    uint8_t reason; // StopReason
+    uint16_t reserved;
+    uint32_t crc; // journalCrc32 of everything above
+};
+static_assert(sizeof(RunRecord) == 32, "run records are 32 bytes");
+
+struct RunLogHeader
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t recordSize;
+};
+
+inline const char *runStopReason(uint8_t code)
+{
+    switch (code)
+    {
+    case STOP_OTHER:
+        return "Stopped";
+    case STOP_TANK_FULL:
+        return "Tank full";
+    case STOP_UGT_EMPTY:
+        return "UGT empty";
+    case STOP_VOLTAGE:
+        return "Voltage";
+    case STOP_OVER_CURRENT:
+        return "Over current";
+    case STOP_UNDER_CURRENT:
+        return "Under current";
+    case STOP_DRY_RUN:
+        return "Dry run";
+    case STOP_TIMER:
+        return "Timer";
+    case STOP_MANUAL:
+        return "Manual";
+    case STOP_WEB:
+        return "Web";
+    }
+    return "Unknown";
+}
@@ -0,0 +1,141 @@
+// screenCompositor.h — Retained widgets for the TFT status and menu screens
+// Each widget owns a fixed rectangle and remembers what it last put on the glass. Screens only
+// set() the text and colours they want; flush() compares that with what is shown and repaints the
+// widgets that differ, so a menu value change is one small text write instead of a full-screen
+// clear. Text is drawn opaque (glyph cells carry the background), and only the strip the old,
+// longer text leaves uncovered is filled; a new background colour repaints the whole rectangle.
+//
+// The painter is anything with
+//   void fill(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t colour);
+//   void text(int16_t x, int16_t y, const char *s, uint16_t fg, uint16_t bg);
+//   int16_t textWidth(const char *s);
+//   int16_t fontHeight();
+// so the same code runs against TFT_eSPI on the target and a recorder on the host.
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#define WIDGET_TEXT 28
+#define WIDGET_INSET 4 // left-aligned text starts this far inside its band
+
+enum : uint8_t
+{
+    ALIGN_LEFT,
+    ALIGN_CENTRE
+};
+
+struct WidgetState
+{
+    char text[WIDGET_TEXT];
+    uint16_t fg;
+    uint16_t bg;
+};
+
+template <uint8_t N>
+class Compositor
+{
+public:
+    Compositor(int16_t width, int16_t height, uint16_t background) : _width(width), _height(height), _background(background) {}
+
+    void place(uint8_t id, int16_t x, int16_t y, int16_t w, int16_t h, uint8_t align = ALIGN_LEFT)
+    {
+        _rect[id] = {x, y, w, h, align};
+        set(id, "", _background, _background);
+    }
+
+    void set(uint8_t id, const char *text, uint16_t fg, uint16_t bg)
+    {
+        WidgetState &want = _want[id];
+        snprintf(want.text, WIDGET_TEXT, "%s", text);
+        want.fg = fg;
+        want.bg = bg;
+    }
+
+    // Someone else drew over the panel (GIF, calibration prompts): the next flush clears it once
+    // and repaints every widget
+    void invalidate()
+    {
+        _valid = false;
+    }
+
+    // Returns the number of widgets repainted
+    template <class Painter>
+    uint8_t flush(Painter &p)
+    {
+        if (!_valid)
+        {
+            p.fill(0, 0, _width, _height, _background);
+            for (uint8_t i = 0; i < N; i++)
+            {
+                _shown[i] = {"", _background, _background};
+                _extent[i] = {0, 0};
+            }
+            _valid = true;
+        }
+
+        uint8_t painted = 0;
+        for (uint8_t i = 0; i < N; i++)
+        {
+            const WidgetState &want = _want[i];
+            WidgetState &shown = _shown[i];
+            if (!strcmp(want.text, shown.text) && want.fg == shown.fg && want.bg == shown.bg)
+                continue;
+            paint(p, i);
+            shown = want;
+            painted++;
+        }
+        return painted;
+    }
+
+private:
+    struct Rect
+    {
+        int16_t x, y, w, h;
+        uint8_t align;
+    };
+
+    struct Extent
+    {
+        int16_t x, w; // pixels the shown text covers on its row
+    };
+
+    int16_t _width, _height;
+    uint16_t _background;
+    bool _valid = false;
+    Rect _rect[N] = {};
+    WidgetState _want[N];
+    WidgetState _shown[N];
+    Extent _extent[N] = {};
+
+    template <class Painter>
+    void paint(Painter &p, uint8_t id)
+    {
+        const Rect &r = _rect[id];
+        const WidgetState &want = _want[id];
+        Extent &old = _extent[id];
+
+        int16_t w = *want.text ? p.textWidth(want.text) : 0;
+        if (w > r.w - 2 * WIDGET_INSET)
+            w = r.w - 2 * WIDGET_INSET;
+        int16_t x = r.align == ALIGN_CENTRE ? r.x + (r.w - w) / 2 : r.x + WIDGET_INSET;
+        int16_t fh = p.fontHeight();
+        int16_t y = r.y + (r.h - fh) / 2;
+
+        if (want.bg != _shown[id].bg)
+            p.fill(r.x, r.y, r.w, r.h, want.bg); // band appears, changes or goes
+        else
+        {
+            // Same background: clear only what the old text covered and the new one will not
+            int16_t oldEnd = old.x + old.w, newEnd = x + w;
+            if (old.w && old.x < x)
+                p.fill(old.x, y, (oldEnd < x ? oldEnd : x) - old.x, fh, want.bg);
+            if (old.w && oldEnd > newEnd)
+                p.fill(newEnd > old.x ? newEnd : old.x, y, oldEnd - (newEnd > old.x ? newEnd : old.x), fh, want.bg);
+        }
+        if (w)
+            p.text(x, y, want.text, want.fg, want.bg);
+        old = {x, w};
+    }
+};
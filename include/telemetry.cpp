@@ -0,0 +1,80 @@
+// telemetry.cpp — What goes into the per-second telemetry store (telemetryStore.h)
+// Included after motorControl.cpp by main.cpp and the simulator. Values are stored as integers in
+// the meters' own resolution so steady readings delta-encode to nothing.
+
+#include <telemetryStore.h>
+
+// Fields per PZEM channel, then one word of float and motor states
+enum : uint8_t
+{
+    TM_VOLTAGE = 0, // 0.1 V
+    TM_CURRENT,     // mA
+    TM_POWER,       // 0.1 W
+    TM_PF,          // 0.01
+    TM_PER_CHANNEL
+};
+#define TELEMETRY_FIELDS (TM_PER_CHANNEL * PZEM_CHANNELS + 1)
+#define TM_STATES (TELEMETRY_FIELDS - 1)
+
+// TM_STATES bits: floats (floatPins order) from bit 0, motors running from 16, motors faulted from 24
+#define TM_RUNNING_BIT 16
+#define TM_FAULT_BIT 24
+static_assert(sizeof(floatPins) <= TM_RUNNING_BIT, "too many floats for the state word");
+
+#define TELEMETRY_FLUSH_S 60 // samples lost at most on a power cut
+
+void telemetrySample(int32_t (&values)[TELEMETRY_FIELDS]);
+void telemetryReadings(int32_t (&values)[TELEMETRY_FIELDS]);
+uint32_t telemetryStateWord();
+float telemetryValue(const int32_t (&values)[TELEMETRY_FIELDS], uint8_t channel, uint8_t field);
+float telemetryScale(uint8_t field);
+
+void telemetrySample(int32_t (&values)[TELEMETRY_FIELDS])
+{
+    telemetryReadings(values);
+    values[TM_STATES] = (int32_t)telemetryStateWord();
+}
+
+// The PZEM fields only; safe from any task (snapshots are seqlocked)
+void telemetryReadings(int32_t (&values)[TELEMETRY_FIELDS])
+{
+    for (uint8_t ch = 0; ch < PZEM_CHANNELS; ch++)
+    {
+        PzemReading r = pzemSnapshots[ch].read();
+        int32_t *v = &values[ch * TM_PER_CHANNEL];
+        v[TM_VOLTAGE] = lroundf(r.voltage * 10);
+        v[TM_CURRENT] = lroundf(r.current * 1000);
+        v[TM_POWER] = lroundf(r.power * 10);
+        v[TM_PF] = lroundf(r.pf * 100);
+    }
+}
+
+// Floats, running and fault bits; reads motors[], so loop() only
+uint32_t telemetryStateWord()
+{
+    uint32_t states = 0;
+    for (uint8_t i = 0; i < sizeof(floatPins); i++)
+        if (floatInputs.level(floatPins[i]))
+            states |= 1UL << i;
+    for (uint8_t k = 0; k < MOTOR_COUNT; k++)
+    {
+        if (motors[k].running)
+            states |= 1UL << (TM_RUNNING_BIT + k);
+        if (motors[k].error >= 2)
+            states |= 1UL << (TM_FAULT_BIT + k);
+    }
+    return states;
+}
+
+// Stored integer back to the meter's unit
+float telemetryValue(const int32_t (&values)[TELEMETRY_FIELDS], uint8_t channel, uint8_t field)
+{
+    return values[channel * TM_PER_CHANNEL + field] * telemetryScale(field);
+}
+
+// Unit per stored step of a per-channel field (TM_VOLTAGE..TM_PF)
+float telemetryScale(uint8_t field)
+{
+    static const float scale[TM_PER_CHANNEL] = {0.1f, 0.001f, 0.1f, 0.01f};
+    return scale[field];
+}
@@ -0,0 +1,405 @@
+// telemetryStore.h — Fixed-footprint circular time series of integer samples
+// One sample is a timestamp (s) plus FIELDS int32 values. Samples are packed into fixed-size blocks
+// as varint(dt) varint(changed-field mask) and a zigzag varint delta per changed field, so a second
+// where nothing moved costs two bytes. Every block starts from zero, so it decodes on its own.
+// Storage layout (Storage supplies read/write(offset, buf, len)):
+//   [0]            StoreHeader, padded to 512 bytes
+//   [512]          index: {seq, firstTime} per block slot, written when a block is opened
+//   [dataOffset]   blockCount slots of TELEMETRY_BLOCK_SIZE bytes: BlockHeader + records
+// Slots are used round robin. The index is sorted by time once rotated to the oldest slot, so both
+// finding the head at boot and seeking to a time are binary searches reading 8 bytes per probe.
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+#ifndef TELEMETRY_BLOCK_SIZE
+#define TELEMETRY_BLOCK_SIZE 4096
+#endif
+
+#define TELEMETRY_MAGIC 0x54434C57 // "WLCT"
+#define TELEMETRY_VERSION 1
+
+struct TelemetryIndexEntry
+{
+    uint32_t seq; // block sequence number, 0 = slot never used
+    uint32_t firstTime;
+};
+
+template <class Storage, uint8_t FIELDS>
+class TelemetryStore
+{
+    static_assert(FIELDS >= 1 && FIELDS <= 32, "the changed-field mask is one 32 bit varint");
+
+    struct StoreHeader
+    {
+        uint32_t magic;
+        uint16_t version;
+        uint16_t fields;
+        uint32_t blockSize;
+        uint32_t blockCount;
+    };
+
+    struct BlockHeader
+    {
+        uint32_t seq; // matches the index entry once the block has been flushed
+        uint32_t firstTime;
+        uint32_t lastTime;
+        uint16_t count; // samples
+        uint16_t bytes; // record bytes after the header
+    };
+
+    static const uint32_t HEADER_BYTES = 512;
+    static const uint16_t PAYLOAD = TELEMETRY_BLOCK_SIZE - sizeof(BlockHeader);
+    static const uint8_t MAX_RECORD = 5 + 5 + 5 * FIELDS; // worst case varint sizes
+
+public:
+    // Decodes samples forward from a seek point; buf is a TELEMETRY_BLOCK_SIZE scratch block
+    class Cursor
+    {
+    public:
+        Cursor(const TelemetryStore &store, uint8_t *buf) : _store(store), _buf(buf) {}
+
+        // Position on the first sample at or after t (false if there is none)
+        bool seek(uint32_t t)
+        {
+            _remaining = 0;
+            uint32_t used = _store.usedBlocks();
+            if (!used)
+                return false;
+
+            // Last block whose first sample is <= t, or the oldest block if t is older than everything
+            uint32_t lo = 0, hi = used;
+            while (hi - lo > 1)
+            {
+                uint32_t mid = lo + (hi - lo) / 2;
+                if (_store.indexEntry(_store.slotAt(mid)).firstTime <= t)
+                    lo = mid;
+                else
+                    hi = mid;
+            }
+            _pos = lo;
+            if (!load())
+                return false;
+            while (peekTime() < t)
+                if (!skip())
+                    return false;
+            return true;
+        }
+
+        // Next sample; false at the end of the store
+        bool next(uint32_t &t, int32_t (&values)[FIELDS])
+        {
+            if (!_remaining && !advance())
+                return false;
+            decode();
+            t = _time;
+            memcpy(values, _values, sizeof(_values));
+            return true;
+        }
+
+    private:
+        const TelemetryStore &_store;
+        uint8_t *_buf;
+        uint32_t _pos = 0; // logical block, 0 = oldest
+        uint16_t _at = 0;  // read offset in the block payload
+        uint16_t _remaining = 0;
+        uint32_t _time = 0;
+        int32_t _values[FIELDS];
+
+        bool load()
+        {
+            while (_pos < _store.usedBlocks())
+            {
+                BlockHeader h;
+                if (_store.loadBlock(_store.slotAt(_pos), _buf, h) && h.count)
+                {
+                    _at = sizeof(BlockHeader);
+                    _remaining = h.count;
+                    _time = h.firstTime;
+                    memset(_values, 0, sizeof(_values));
+                    return true;
+                }
+                _pos++; // never flushed (power cut), nothing to read
+            }
+            return false;
+        }
+
+        bool advance()
+        {
+            _pos++;
+            return load();
+        }
+
+        uint32_t peekTime()
+        {
+            uint16_t at = _at;
+            return _time + readVarint(_buf, at);
+        }
+
+        bool skip()
+        {
+            decode();
+            return _remaining || advance();
+        }
+
+        void decode()
+        {
+            _time += readVarint(_buf, _at);
+            uint32_t mask = readVarint(_buf, _at);
+            for (uint8_t f = 0; f < FIELDS; f++)
+                if (mask & (1UL << f))
+                {
+                    uint32_t z = readVarint(_buf, _at);
+                    _values[f] += (int32_t)((z >> 1) ^ (0U - (z & 1)));
+                }
+            _remaining--;
+        }
+    };
+
+    TelemetryStore(Storage &storage, uint32_t blockCount) : _storage(storage), _blockCount(blockCount)
+    {
+        _dataOffset = (HEADER_BYTES + blockCount * sizeof(TelemetryIndexEntry) + TELEMETRY_BLOCK_SIZE - 1) / TELEMETRY_BLOCK_SIZE * TELEMETRY_BLOCK_SIZE;
+    }
+
+    // Mount an existing store (same geometry) or format a new one; recovers the head block
+    bool begin()
+    {
+        StoreHeader h = {};
+        _storage.read(0, &h, sizeof(h));
+        if (h.magic != TELEMETRY_MAGIC || h.version != TELEMETRY_VERSION || h.fields != FIELDS ||
+            h.blockSize != TELEMETRY_BLOCK_SIZE || h.blockCount != _blockCount)
+        {
+            if (!format())
+                return false;
+        }
+
+        // Slots 0..head carry increasing sequence numbers, later slots are older laps or unused
+        uint32_t seq0 = indexEntry(0).seq;
+        _open = false;
+        _used = 0;
+        if (!seq0)
+            return true;
+        uint32_t lo = 0, hi = _blockCount;
+        while (hi - lo > 1)
+        {
+            uint32_t mid = lo + (hi - lo) / 2;
+            if (indexEntry(mid).seq >= seq0)
+                lo = mid;
+            else
+                hi = mid;
+        }
+        _head = lo;
+        _seq = indexEntry(_head).seq;
+        _used = (_head + 1 < _blockCount && indexEntry(_head + 1).seq) ? _blockCount : _head + 1;
+
+        BlockHeader bh;
+        _lastTime = loadBlock(_head, _block, bh) ? bh.lastTime : indexEntry(_head).firstTime;
+        return true;
+    }
+
+    // Samples must be strictly newer than the previous one; false if out of order or on a write error
+    bool append(uint32_t t, const int32_t (&values)[FIELDS])
+    {
+        if (_used && (int32_t)(t - _lastTime) <= 0)
+            return false;
+
+        uint8_t rec[MAX_RECORD];
+        uint16_t len = 0;
+        if (_open)
+            len = encode(rec, t, values);
+        if (!_open || sizeof(BlockHeader) + _hdr.bytes + len > TELEMETRY_BLOCK_SIZE)
+        {
+            if (_open && !seal())
+                return false;
+            openBlock(t);
+            len = encode(rec, t, values);
+        }
+
+        memcpy(_block + sizeof(BlockHeader) + _hdr.bytes, rec, len);
+        _hdr.bytes += len;
+        _appended += len;
+        _hdr.count++;
+        _hdr.lastTime = t;
+        _lastTime = t;
+        memcpy(_prev, values, sizeof(_prev));
+        return true;
+    }
+
+    // Write the samples appended since the last flush (record bytes first, then the block header)
+    bool flush()
+    {
+        if (!_open || _flushed == _hdr.bytes)
+            return true;
+        uint32_t base = blockOffset(_head);
+        uint32_t from = sizeof(BlockHeader) + _flushed;
+        bool ok = _storage.write(base + from, _block + from, _hdr.bytes - _flushed);
+        memcpy(_block, &_hdr, sizeof(_hdr));
+        ok = ok && _storage.write(base, _block, sizeof(_hdr));
+        if (ok)
+            _flushed = _hdr.bytes;
+        return ok;
+    }
+
+    uint32_t usedBlocks() const
+    {
+        return _used;
+    }
+
+    uint32_t blockCount() const
+    {
+        return _blockCount;
+    }
+
+    uint32_t lastTime() const
+    {
+        return _lastTime;
+    }
+
+    // Oldest timestamp still held (0 if empty)
+    uint32_t firstTime() const
+    {
+        return _used ? indexEntry(slotAt(0)).firstTime : 0;
+    }
+
+    // Encoded record bytes appended since begin()
+    uint32_t appendedBytes() const
+    {
+        return _appended;
+    }
+
+    // Bytes the store occupies on the medium
+    uint32_t footprint() const
+    {
+        return _dataOffset + _blockCount * TELEMETRY_BLOCK_SIZE;
+    }
+
+private:
+    Storage &_storage;
+    uint32_t _blockCount;
+    uint32_t _dataOffset;
+    uint32_t _head = 0; // slot of the newest block
+    uint32_t _used = 0; // slots holding data
+    uint32_t _seq = 0;
+    uint32_t _lastTime = 0;
+    bool _open = false; // _block is the head block and accepts samples
+    uint16_t _flushed = 0;
+    uint32_t _appended = 0;
+    BlockHeader _hdr;
+    int32_t _prev[FIELDS];
+    uint8_t _block[TELEMETRY_BLOCK_SIZE];
+
+    bool format()
+    {
+        StoreHeader h = {TELEMETRY_MAGIC, TELEMETRY_VERSION, FIELDS, TELEMETRY_BLOCK_SIZE, _blockCount};
+        uint8_t zero[HEADER_BYTES] = {};
+        memcpy(zero, &h, sizeof(h));
+        if (!_storage.write(0, zero, sizeof(zero)))
+            return false;
+        memset(zero, 0, sizeof(zero));
+        for (uint32_t off = HEADER_BYTES; off < _dataOffset; off += sizeof(zero))
+            if (!_storage.write(off, zero, sizeof(zero)))
+                return false;
+        return true;
+    }
+
+    uint32_t blockOffset(uint32_t slot) const
+    {
+        return _dataOffset + slot * TELEMETRY_BLOCK_SIZE;
+    }
+
+    // Logical block i (0 = oldest) to slot
+    uint32_t slotAt(uint32_t i) const
+    {
+        uint32_t oldest = _used < _blockCount ? 0 : (_head + 1) % _blockCount;
+        return (oldest + i) % _blockCount;
+    }
+
+    TelemetryIndexEntry indexEntry(uint32_t slot) const
+    {
+        TelemetryIndexEntry e = {};
+        _storage.read(HEADER_BYTES + slot * sizeof(e), &e, sizeof(e));
+        return e;
+    }
+
+    // Block contents into buf; the open block comes from RAM so unflushed samples are visible
+    bool loadBlock(uint32_t slot, uint8_t *buf, BlockHeader &h) const
+    {
+        if (_open && slot == _head)
+        {
+            memcpy(buf, _block, sizeof(BlockHeader) + _hdr.bytes);
+            memcpy(buf, &_hdr, sizeof(_hdr));
+            h = _hdr;
+            return true;
+        }
+        if (!_storage.read(blockOffset(slot), buf, sizeof(BlockHeader)))
+            return false;
+        memcpy(&h, buf, sizeof(h));
+        if (h.seq != indexEntry(slot).seq || h.bytes > PAYLOAD)
+            return false;
+        return _storage.read(blockOffset(slot) + sizeof(BlockHeader), buf + sizeof(BlockHeader), h.bytes);
+    }
+
+    bool seal()
+    {
+        bool ok = flush();
+        _open = false;
+        return ok;
+    }
+
+    void openBlock(uint32_t t)
+    {
+        _head = _used ? (_head + 1) % _blockCount : 0;
+        if (_used < _blockCount)
+            _used++;
+        _hdr = {++_seq, t, t, 0, 0};
+        _flushed = 0;
+        _open = true;
+        memset(_prev, 0, sizeof(_prev));
+        TelemetryIndexEntry e = {_seq, t};
+        _storage.write(HEADER_BYTES + _head * sizeof(e), &e, sizeof(e));
+    }
+
+    uint16_t encode(uint8_t *out, uint32_t t, const int32_t (&values)[FIELDS])
+    {
+        uint16_t n = 0;
+        uint32_t mask = 0;
+        for (uint8_t f = 0; f < FIELDS; f++)
+            if (values[f] != _prev[f])
+                mask |= 1UL << f;
+        n += writeVarint(out + n, _hdr.count ? t - _hdr.lastTime : 0);
+        n += writeVarint(out + n, mask);
+        for (uint8_t f = 0; f < FIELDS; f++)
+            if (mask & (1UL << f))
+            {
+                int32_t d = (int32_t)((uint32_t)values[f] - (uint32_t)_prev[f]);
+                n += writeVarint(out + n, ((uint32_t)d << 1) ^ (uint32_t)(d >> 31));
+            }
+        return n;
+    }
+
+    static uint8_t writeVarint(uint8_t *out, uint32_t v)
+    {
+        uint8_t n = 0;
+        while (v >= 0x80)
+        {
+            out[n++] = (uint8_t)(v | 0x80);
+            v >>= 7;
+        }
+        out[n++] = (uint8_t)v;
+        return n;
+    }
+
+    static uint32_t readVarint(const uint8_t *buf, uint16_t &at)
+    {
+        uint32_t v = 0;
+        for (uint8_t shift = 0; shift < 35 && at < TELEMETRY_BLOCK_SIZE; shift += 7)
+        {
+            uint8_t b = buf[at++];
+            v |= (uint32_t)(b & 0x7F) << shift;
+            if (!(b & 0x80))
+                break;
+        }
+        return v;
+    }
+};
@@ -60,7 +60,7 @@ void tftMeterUpdate()
         if (d >= 360)
             d = 0;
         // value[0] = 50 + 50 * sin((d + 0) * 0.0174532925);
-        voltage = 230;
+        float voltage = meterFor(MOTOR_BORE).read().voltage;
         int i = (voltage / 3);
         plotNeedle(i, 0); // It takes between 2 and 12ms to replot the needle with zero delay
     }
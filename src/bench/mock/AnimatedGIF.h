@@ -0,0 +1,41 @@
+// AnimatedGIF.h — Decoder mock: opens anything and has no frames
+#pragma once
+
+#include <stdint.h>
+
+#define BIG_ENDIAN_PIXELS 1
+
+typedef struct
+{
+    void *fHandle;
+    int32_t iPos;
+    int32_t iSize;
+} GIFFILE;
+
+typedef struct
+{
+    int iX, iY, y, iWidth, iHeight;
+    uint16_t *pPalette;
+    uint8_t *pPixels;
+    uint8_t ucDisposalMethod, ucTransparent, ucHasTransparency, ucBackground;
+    void *pUser;
+} GIFDRAW;
+
+typedef void *(*GIF_OPEN_CALLBACK)(const char *, int32_t *);
+typedef void (*GIF_CLOSE_CALLBACK)(void *);
+typedef int32_t (*GIF_READ_CALLBACK)(GIFFILE *, uint8_t *, int32_t);
+typedef int32_t (*GIF_SEEK_CALLBACK)(GIFFILE *, int32_t);
+typedef void (*GIF_DRAW_CALLBACK)(GIFDRAW *);
+
+class AnimatedGIF
+{
+public:
+    void begin(int) {}
+    int open(const char *, GIF_OPEN_CALLBACK, GIF_CLOSE_CALLBACK, GIF_READ_CALLBACK, GIF_SEEK_CALLBACK, GIF_DRAW_CALLBACK) { return 1; }
+    int playFrame(bool, int *, void * = nullptr) { return 0; }
+    void close() {}
+    void reset() {}
+    int getLastError() { return 0; }
+    int getCanvasWidth() { return 0; }
+    int getCanvasHeight() { return 0; }
+};
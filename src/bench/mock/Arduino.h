@@ -0,0 +1,286 @@
+// Arduino.h — Host stand-in for the Arduino-ESP32 core, just enough for src/main.cpp to build
+// String is backed by std::string, so its heap traffic shows up in the bench allocation counters.
+// millis() is a virtual clock (mockMillis) the bench advances; FreeRTOS calls do nothing.
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <strings.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include <string>
+#include <algorithm>
+#include <atomic>
+
+using std::max;
+using std::min;
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 1
+#define OUTPUT 3
+#define INPUT_PULLUP 5
+#define IRAM_ATTR
+#define PROGMEM
+#define F(x) x
+#define TWO_PI 6.283185307179586
+#define DEG_TO_RAD 0.017453292519943295
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+#define GPIO_IN_REG 0x3FF4403C
+#define REG_READ(r) mockRegRead(r)
+
+// Allocations made while storing mock data (socket output, file contents) are not the firmware's:
+// the bench heap counters skip them while an UntrackedHeap is alive.
+extern int mockUntracked;
+
+struct UntrackedHeap
+{
+    UntrackedHeap() { mockUntracked++; }
+    ~UntrackedHeap() { mockUntracked--; }
+};
+
+extern unsigned long mockMillis;
+extern uint32_t mockMillisStep; // added on every millis() call
+
+unsigned long millis();
+unsigned long micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+int digitalRead(uint8_t pin);
+void digitalWrite(uint8_t pin, uint8_t level);
+void pinMode(uint8_t pin, uint8_t mode);
+inline uint32_t mockRegRead(uint32_t) { return 0; }
+inline void yield() {}
+char *dtostrf(double value, signed char width, unsigned char prec, char *buf);
+long map(long x, long inMin, long inMax, long outMin, long outMax);
+inline long random(long max) { return rand() % max; }
+
+class String
+{
+public:
+    std::string s;
+
+    String(const char *c = "") : s(c ? c : "") {}
+    String(const std::string &x) : s(x) {}
+    String(char c) : s(1, c) {}
+    String(int v, unsigned char = 10) : s(std::to_string(v)) {}
+    String(unsigned v, unsigned char = 10) : s(std::to_string(v)) {}
+    String(long v, unsigned char = 10) : s(std::to_string(v)) {}
+    String(unsigned long v, unsigned char = 10) : s(std::to_string(v)) {}
+    String(long long v) : s(std::to_string(v)) {}
+    String(unsigned long long v) : s(std::to_string(v)) {}
+    String(float v, unsigned char decimals = 2) { format(v, decimals); }
+    String(double v, unsigned char decimals = 2) { format(v, decimals); }
+
+    const char *c_str() const { return s.c_str(); }
+    unsigned length() const { return s.size(); }
+    bool isEmpty() const { return s.empty(); }
+    bool reserve(unsigned n)
+    {
+        s.reserve(n);
+        return true;
+    }
+    char operator[](unsigned i) const { return s[i]; }
+
+    bool startsWith(const String &x) const { return s.compare(0, x.s.size(), x.s) == 0; }
+    bool endsWith(const String &x) const
+    {
+        return s.size() >= x.s.size() && s.compare(s.size() - x.s.size(), x.s.size(), x.s) == 0;
+    }
+    bool equalsIgnoreCase(const String &x) const { return !strcasecmp(s.c_str(), x.s.c_str()); }
+    int indexOf(char c) const { return found(s.find(c)); }
+    int indexOf(const String &x) const { return found(s.find(x.s)); }
+    String substring(unsigned from) const { return String(s.substr(from)); }
+    String substring(unsigned from, unsigned to) const { return String(s.substr(from, to - from)); }
+    float toFloat() const { return atof(s.c_str()); }
+    long toInt() const { return atol(s.c_str()); }
+
+    void remove(unsigned i) { s.erase(i); }
+    void remove(unsigned i, unsigned n) { s.erase(i, n); }
+    void replace(const String &a, const String &b)
+    {
+        size_t p = 0;
+        while ((p = s.find(a.s, p)) != std::string::npos)
+        {
+            s.replace(p, a.s.size(), b.s);
+            p += b.s.size();
+        }
+    }
+    void trim() {}
+    void toLowerCase() {}
+
+    String &operator+=(const String &o)
+    {
+        s += o.s;
+        return *this;
+    }
+    String &operator+=(const char *o)
+    {
+        s += o;
+        return *this;
+    }
+    String &operator+=(char o)
+    {
+        s += o;
+        return *this;
+    }
+    bool operator==(const String &o) const { return s == o.s; }
+    bool operator==(const char *o) const { return s == o; }
+    bool operator!=(const String &o) const { return s != o.s; }
+
+private:
+    void format(double v, unsigned char decimals)
+    {
+        char buf[32];
+        snprintf(buf, sizeof(buf), "%.*f", decimals, v);
+        s = buf;
+    }
+    static int found(size_t p) { return p == std::string::npos ? -1 : (int)p; }
+};
+
+inline String operator+(const String &a, const String &b) { return String(a.s + b.s); }
+inline String operator+(const String &a, const char *b) { return String(a.s + b); }
+inline String operator+(const char *a, const String &b) { return String(a + b.s); }
+
+// print()/println() output is discarded; write() is what sockets and files implement
+class Print
+{
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t) = 0;
+    virtual size_t write(const uint8_t *buf, size_t n)
+    {
+        for (size_t i = 0; i < n; i++)
+            write(buf[i]);
+        return n;
+    }
+    size_t write(const char *str) { return write((const uint8_t *)str, strlen(str)); }
+    virtual void flush() {}
+
+    size_t print(const String &) { return 0; }
+    size_t print(const char *) { return 0; }
+    size_t print(char) { return 0; }
+    size_t print(int, int = 10) { return 0; }
+    size_t print(unsigned, int = 10) { return 0; }
+    size_t print(long, int = 10) { return 0; }
+    size_t print(unsigned long, int = 10) { return 0; }
+    size_t print(double, int = 2) { return 0; }
+    size_t println(const String &) { return 0; }
+    size_t println(const char * = "") { return 0; }
+    size_t println(int) { return 0; }
+    size_t println(double, int = 2) { return 0; }
+    size_t printf(const char *, ...) __attribute__((format(printf, 2, 3))) { return 0; }
+};
+
+class Stream : public Print
+{
+public:
+    virtual int available() { return 0; }
+    virtual int read() { return -1; }
+    virtual int peek() { return -1; }
+    size_t readBytes(uint8_t *, size_t) { return 0; }
+    size_t readBytes(char *, size_t) { return 0; }
+    void setTimeout(unsigned long) {}
+    String readStringUntil(char terminator)
+    {
+        std::string r;
+        int c;
+        while ((c = read()) >= 0 && c != terminator)
+            r += (char)c;
+        return String(r);
+    }
+};
+
+class HardwareSerial : public Stream
+{
+public:
+    size_t write(uint8_t) override { return 1; }
+    using Print::write;
+    void begin(unsigned long, uint32_t = 0, int8_t = -1, int8_t = -1) {}
+    void end() {}
+};
+
+extern HardwareSerial Serial, Serial1, Serial2;
+#define SERIAL_8N1 0x800001c
+
+// ---------------- FreeRTOS ----------------
+// Single threaded on the host: tasks are never started, and xTaskGetCurrentTaskHandle() returns
+// mockCurrentTask so the bench can play httpTask or loop() for HttpServer.
+typedef void *TaskHandle_t;
+typedef void *SemaphoreHandle_t;
+typedef void *QueueHandle_t;
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef int portMUX_TYPE;
+
+#define portMUX_INITIALIZER_UNLOCKED 0
+#define portENTER_CRITICAL(x) (void)(x)
+#define portEXIT_CRITICAL(x) (void)(x)
+#define portENTER_CRITICAL_ISR(x) (void)(x)
+#define portEXIT_CRITICAL_ISR(x) (void)(x)
+#define portMAX_DELAY 0xffffffff
+#define portTICK_PERIOD_MS 1
+#define pdTRUE 1
+#define pdFALSE 0
+#define pdPASS 1
+#define pdMS_TO_TICKS(x) (x)
+
+extern TaskHandle_t mockCurrentTask;
+inline TaskHandle_t xTaskGetCurrentTaskHandle() { return mockCurrentTask; }
+inline BaseType_t xTaskCreatePinnedToCore(void (*)(void *), const char *, uint32_t, void *, int, TaskHandle_t *, int) { return pdPASS; }
+inline void vTaskDelay(TickType_t) {}
+inline void vTaskDelayUntil(TickType_t *, TickType_t) {}
+inline TickType_t xTaskGetTickCount() { return mockMillis; }
+inline SemaphoreHandle_t xSemaphoreCreateMutex() { return nullptr; }
+inline BaseType_t xSemaphoreTake(SemaphoreHandle_t, TickType_t) { return pdTRUE; }
+inline BaseType_t xSemaphoreGive(SemaphoreHandle_t) { return pdTRUE; }
+inline QueueHandle_t xQueueCreate(uint32_t, uint32_t) { return nullptr; }
+inline BaseType_t xQueueSend(QueueHandle_t, const void *, TickType_t) { return pdTRUE; }
+inline BaseType_t xQueueReceive(QueueHandle_t, void *, TickType_t) { return pdFALSE; }
+inline BaseType_t xQueueOverwrite(QueueHandle_t, const void *) { return pdTRUE; }
+inline uint32_t ulTaskNotifyTake(BaseType_t, TickType_t) { return 0; }
+inline BaseType_t xTaskNotifyGive(TaskHandle_t) { return pdTRUE; }
+
+struct hw_timer_t;
+inline hw_timer_t *timerBegin(uint8_t, uint16_t, bool) { return nullptr; }
+inline void timerAttachInterrupt(hw_timer_t *, void (*)(), bool) {}
+inline void timerAlarmWrite(hw_timer_t *, uint64_t, bool) {}
+inline void timerAlarmEnable(hw_timer_t *) {}
+
+// ---------------- ESP-IDF ----------------
+class EspClass
+{
+public:
+    void restart() {}
+    uint32_t getFreeHeap() { return 0; }
+    uint32_t getMinFreeHeap() { return 0; }
+    uint32_t getPsramSize() { return 0; }
+};
+extern EspClass ESP;
+
+typedef enum
+{
+    ESP_RST_UNKNOWN,
+    ESP_RST_POWERON,
+    ESP_RST_EXT,
+    ESP_RST_SW,
+    ESP_RST_PANIC,
+    ESP_RST_INT_WDT,
+    ESP_RST_TASK_WDT,
+    ESP_RST_WDT,
+    ESP_RST_DEEPSLEEP,
+    ESP_RST_BROWNOUT
+} esp_reset_reason_t;
+
+inline esp_reset_reason_t esp_reset_reason() { return ESP_RST_POWERON; }
+inline void *ps_malloc(size_t n) { return malloc(n); }
+inline uint32_t esp_random() { return 0x1234abcd; }
+inline int64_t esp_timer_get_time() { return (int64_t)mockMillis * 1000; }
+inline void configTime(long, int, const char *, const char * = nullptr, const char * = nullptr) {}
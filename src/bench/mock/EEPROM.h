@@ -0,0 +1,56 @@
+// EEPROM.h — EEPROM emulation mock with the ESP32 core's dirty tracking
+// put() always marks the cache dirty; write() only when the byte changes; commit() counts as a
+// flash write only when dirty, like the NVS blob rewrite on the target.
+#pragma once
+
+#include <Arduino.h>
+
+class EEPROMClass
+{
+public:
+    uint8_t data[512];
+    size_t commits = 0; // blob rewrites
+
+    EEPROMClass() { memset(data, 0xFF, sizeof(data)); }
+    bool begin(size_t) { return true; }
+    size_t length() { return sizeof(data); }
+    uint8_t *getDataPtr() { return data; }
+
+    uint8_t read(int address) { return data[address]; }
+    void write(int address, uint8_t value)
+    {
+        if (data[address] != value)
+        {
+            data[address] = value;
+            _dirty = true;
+        }
+    }
+
+    template <class T>
+    T &get(int address, T &t)
+    {
+        memcpy(&t, data + address, sizeof(T));
+        return t;
+    }
+
+    template <class T>
+    const T &put(int address, const T &t)
+    {
+        memcpy(data + address, &t, sizeof(T));
+        _dirty = true;
+        return t;
+    }
+
+    bool commit()
+    {
+        if (_dirty)
+            commits++;
+        _dirty = false;
+        return true;
+    }
+
+private:
+    bool _dirty = false;
+};
+
+extern EEPROMClass EEPROM;
@@ -0,0 +1,167 @@
+// FS.h — In-memory file system behind the SD mock
+// Files are std::string contents keyed by absolute path (mockFiles()); a directory exists while
+// any file lives under it. getLastWrite() reads mockMtimes(), which the bench sets by hand.
+#pragma once
+
+#include <Arduino.h>
+#include <map>
+#include <string>
+
+#define FILE_READ "r"
+#define FILE_WRITE "w"
+#define FILE_APPEND "a"
+
+namespace fs
+{
+    inline std::map<std::string, std::string> &mockFiles()
+    {
+        static std::map<std::string, std::string> files;
+        return files;
+    }
+
+    inline std::map<std::string, time_t> &mockMtimes()
+    {
+        static std::map<std::string, time_t> mtimes;
+        return mtimes;
+    }
+
+    class File : public Stream
+    {
+    public:
+        File() {}
+        File(std::string *data, const std::string &path) : _data(data), _path(path) {}
+
+        static File directory(const std::string &path)
+        {
+            File f;
+            f._dir = true;
+            f._path = path;
+            return f;
+        }
+
+        size_t write(uint8_t c) override { return write(&c, 1); }
+        size_t write(const uint8_t *buf, size_t n) override
+        {
+            if (!_data)
+                return 0;
+            UntrackedHeap untracked;
+            if (_pos + n > _data->size())
+                _data->resize(_pos + n);
+            memcpy(&(*_data)[_pos], buf, n);
+            _pos += n;
+            return n;
+        }
+        using Print::write;
+
+        int available() override { return _data && _pos < _data->size() ? (int)(_data->size() - _pos) : 0; }
+        int read() override { return available() ? (uint8_t)(*_data)[_pos++] : -1; }
+        int peek() override { return available() ? (uint8_t)(*_data)[_pos] : -1; }
+        size_t read(uint8_t *buf, size_t n)
+        {
+            size_t k = available();
+            if (k > n)
+                k = n;
+            if (k)
+                memcpy(buf, &(*_data)[_pos], k);
+            _pos += k;
+            return k;
+        }
+        bool seek(uint32_t pos)
+        {
+            if (!_data)
+                return false;
+            _pos = pos;
+            return true;
+        }
+        size_t position() const { return _pos; }
+        size_t size() const { return _data ? _data->size() : 0; }
+        void close()
+        {
+            _data = nullptr;
+            _dir = false;
+        }
+        operator bool() const { return _data || _dir; }
+
+        const char *path() const { return _path.c_str(); }
+        const char *name() const
+        {
+            size_t slash = _path.rfind('/');
+            return _path.c_str() + (slash == std::string::npos ? 0 : slash + 1);
+        }
+        time_t getLastWrite()
+        {
+            std::map<std::string, time_t>::iterator it = mockMtimes().find(_path);
+            return it == mockMtimes().end() ? 0 : it->second;
+        }
+
+        bool isDirectory() { return _dir; }
+        File openNextFile()
+        {
+            if (!_dir)
+                return File();
+            std::string prefix = _path + "/";
+            std::map<std::string, std::string> &files = mockFiles();
+            std::map<std::string, std::string>::iterator it = files.upper_bound(_last.empty() ? prefix : _last);
+            if (it == files.end() || it->first.compare(0, prefix.size(), prefix))
+                return File();
+            _last = it->first;
+            return File(&it->second, it->first);
+        }
+
+    private:
+        std::string *_data = nullptr;
+        size_t _pos = 0;
+        std::string _path;
+        bool _dir = false;
+        std::string _last; // directory iteration
+    };
+
+    class FS
+    {
+    public:
+        File open(const char *path, const char *mode = FILE_READ, bool = false)
+        {
+            UntrackedHeap untracked;
+            std::map<std::string, std::string> &files = mockFiles();
+            std::string key(path);
+            if (mode[0] == 'w')
+            {
+                files[key].clear();
+                return File(&files[key], key);
+            }
+            if (mode[0] == 'a')
+                files[key]; // append creates the file
+            std::map<std::string, std::string>::iterator it = files.find(key);
+            if (it == files.end())
+            {
+                std::string prefix = key + "/";
+                std::map<std::string, std::string>::iterator d = files.lower_bound(prefix);
+                if (d != files.end() && !d->first.compare(0, prefix.size(), prefix))
+                    return File::directory(key);
+                return File();
+            }
+            File f(&it->second, key);
+            if (mode[0] == 'a')
+                f.seek(it->second.size());
+            return f;
+        }
+        File open(const String &path, const char *mode = FILE_READ, bool create = false) { return open(path.c_str(), mode, create); }
+
+        bool exists(const char *path) { return mockFiles().count(path) > 0; }
+        bool exists(const String &path) { return exists(path.c_str()); }
+        bool remove(const char *path) { return mockFiles().erase(path) > 0; }
+        bool mkdir(const char *) { return true; }
+        bool rename(const char *from, const char *to)
+        {
+            std::map<std::string, std::string> &files = mockFiles();
+            if (!files.count(from))
+                return false;
+            files[to] = files[from];
+            files.erase(from);
+            return true;
+        }
+    };
+}
+
+using fs::File;
+using fs::FS;
@@ -0,0 +1,12 @@
+// OneButton.h — Button mock: never fires
+#pragma once
+
+class OneButton
+{
+public:
+    OneButton(int, bool) {}
+    void tick() {}
+    void attachClick(void (*)()) {}
+    void attachLongPressStart(void (*)()) {}
+    void attachLongPressStop(void (*)()) {}
+};
@@ -0,0 +1,14 @@
+// SD.h — SD card mock over the in-memory FS.h
+#pragma once
+
+#include <FS.h>
+
+class SDFS : public fs::FS
+{
+public:
+    bool begin(uint8_t = 5) { return true; }
+    uint64_t totalBytes() { return 0; }
+    uint64_t usedBytes() { return 0; }
+};
+
+extern SDFS SD;
@@ -0,0 +1,2 @@
+// SPI.h — nothing needed on the host
+#pragma once
@@ -0,0 +1,93 @@
+// TFT_eSPI.h — Display mock: every drawing call is accepted and discarded
+#pragma once
+
+#include <Arduino.h>
+
+#define TFT_BLACK 0x0000
+#define TFT_NAVY 0x000F
+#define TFT_BLUE 0x001F
+#define TFT_GREEN 0x07E0
+#define TFT_CYAN 0x07FF
+#define TFT_DARKGREY 0x7BEF
+#define TFT_RED 0xF800
+#define TFT_MAGENTA 0xF81F
+#define TFT_ORANGE 0xFDA0
+#define TFT_YELLOW 0xFFE0
+#define TFT_WHITE 0xFFFF
+#define TL_DATUM 0
+#define ML_DATUM 3
+#define MC_DATUM 4
+
+class TFT_eSPI : public Print
+{
+public:
+    size_t write(uint8_t) override { return 1; }
+    using Print::write;
+
+    void init() {}
+    void setRotation(int) {}
+    int16_t width() { return 320; }
+    int16_t height() { return 240; }
+    void setSwapBytes(bool) {}
+    bool getSwapBytes() { return false; }
+
+    void fillScreen(uint32_t) {}
+    void fillRect(int32_t, int32_t, int32_t, int32_t, uint32_t) {}
+    void drawRect(int32_t, int32_t, int32_t, int32_t, uint32_t) {}
+    void drawLine(int32_t, int32_t, int32_t, int32_t, uint32_t) {}
+    void drawFastHLine(int32_t, int32_t, int32_t, uint32_t) {}
+    void drawPixel(int32_t, int32_t, uint32_t) {}
+    void drawCircle(int32_t, int32_t, int32_t, uint32_t) {}
+    void fillCircle(int32_t, int32_t, int32_t, uint32_t) {}
+    void fillTriangle(int32_t, int32_t, int32_t, int32_t, int32_t, int32_t, uint32_t) {}
+
+    void setCursor(int16_t, int16_t) {}
+    void setTextSize(uint8_t) {}
+    void setTextFont(uint8_t) {}
+    void setFreeFont(const void *) {}
+    void setTextColor(uint16_t) {}
+    void setTextColor(uint16_t, uint16_t, bool = false) {}
+    void setTextDatum(uint8_t) {}
+    void setTextPadding(uint16_t) {}
+    void setTextWrap(bool, bool = false) {}
+    int16_t textWidth(const String &) { return 0; }
+    int16_t textWidth(const char *) { return 0; }
+    int16_t fontHeight() { return 16; }
+    int16_t drawString(const String &, int32_t, int32_t) { return 0; }
+    int16_t drawString(const char *, int32_t, int32_t) { return 0; }
+    int16_t drawString(const char *, int32_t, int32_t, uint8_t) { return 0; }
+    int16_t drawCentreString(const char *, int32_t, int32_t, uint8_t) { return 0; }
+    int16_t drawRightString(const char *, int32_t, int32_t, uint8_t) { return 0; }
+    int16_t drawNumber(long, int32_t, int32_t, uint8_t = 1) { return 0; }
+
+    void startWrite() {}
+    void endWrite() {}
+    void setAddrWindow(int32_t, int32_t, int32_t, int32_t) {}
+    void pushPixels(const void *, uint32_t) {}
+    void pushImage(int32_t, int32_t, int32_t, int32_t, uint16_t *) {}
+    bool initDMA(bool = false) { return true; }
+    void pushImageDMA(int32_t, int32_t, int32_t, int32_t, uint16_t *, uint16_t * = nullptr) {}
+    void pushPixelsDMA(uint16_t *, uint32_t) {}
+    bool dmaBusy() { return false; }
+    void dmaWait() {}
+};
+
+class TFT_eSprite : public TFT_eSPI
+{
+public:
+    TFT_eSprite(TFT_eSPI *) {}
+    void *createSprite(int16_t, int16_t, uint8_t = 1) { return this; }
+    void deleteSprite() {}
+    bool created() { return true; }
+    void setColorDepth(int8_t) {}
+    void *getPointer() { return nullptr; }
+    int16_t width() { return 320; }
+    int16_t height() { return 20; }
+    void fillSprite(uint32_t) {}
+    void pushSprite(int32_t, int32_t) {}
+    void pushSprite(int32_t, int32_t, uint16_t) {}
+    bool pushSprite(int32_t, int32_t, int32_t, int32_t, int32_t, int32_t) { return true; }
+    void pushToSprite(TFT_eSprite *, int32_t, int32_t) {}
+    void setScrollRect(int32_t, int32_t, int32_t, int32_t, uint16_t = 0) {}
+    void scroll(int16_t, int16_t = 0) {}
+};
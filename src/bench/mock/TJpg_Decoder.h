@@ -0,0 +1,14 @@
+// TJpg_Decoder.h — JPEG decoder mock
+#pragma once
+
+#include <SD.h>
+
+class TJpg
+{
+public:
+    void setCallback(bool (*)(int16_t, int16_t, uint16_t, uint16_t, uint16_t *)) {}
+    void setSwapBytes(bool) {}
+    int drawFsJpg(int, int, const char *, fs::FS &) { return 0; }
+};
+
+extern TJpg TJpgDec;
@@ -0,0 +1,22 @@
+// WebServer.h — The parts of the ESP32 WebServer header main.cpp still uses
+// Requests go through HttpServer (include/httpServer.cpp) over the WiFi.h socket mocks, so only
+// the method enum and content length markers are needed here.
+#pragma once
+
+#include <WiFi.h>
+#include <FS.h>
+
+enum HTTPMethod
+{
+    HTTP_ANY,
+    HTTP_GET,
+    HTTP_HEAD,
+    HTTP_POST,
+    HTTP_PUT,
+    HTTP_PATCH,
+    HTTP_DELETE,
+    HTTP_OPTIONS
+};
+
+#define CONTENT_LENGTH_UNKNOWN ((size_t)-1)
+#define CONTENT_LENGTH_NOT_SET ((size_t)-2)
@@ -0,0 +1,114 @@
+// WiFi.h — Socket mocks for HttpServer
+// A MockSock is one TCP connection: the bench fills `in` with a request, queues the socket with
+// mockAccept(), and reads the response back from `out` once `closed` is set. `room` caps a single
+// write() like a full send buffer would.
+#pragma once
+
+#include <Arduino.h>
+#include <deque>
+#include <string>
+
+#define WIFI_STA 1
+
+class IPAddress
+{
+public:
+    String toString() const { return "192.168.4.1"; }
+    uint8_t operator[](int i) const
+    {
+        static const uint8_t octets[] = {192, 168, 4, 1};
+        return octets[i];
+    }
+};
+
+struct MockSock
+{
+    std::string in;
+    std::string out;
+    size_t room = 1436; // bytes one write() takes
+    bool connected = true;
+    bool closed = false; // the server stopped its client
+};
+
+extern std::deque<MockSock *> mockPending; // accepted in order by WiFiServer::accept()
+
+inline void mockAccept(MockSock *sock)
+{
+    mockPending.push_back(sock);
+}
+
+class WiFiClient : public Stream
+{
+public:
+    MockSock *sock = nullptr;
+
+    size_t write(uint8_t c) override { return write(&c, 1); }
+    size_t write(const uint8_t *buf, size_t n) override
+    {
+        if (!sock)
+            return n;
+        if (n > sock->room)
+            n = sock->room;
+        UntrackedHeap untracked;
+        sock->out.append((const char *)buf, n);
+        return n;
+    }
+    using Print::write;
+
+    int available() override { return sock ? (int)sock->in.size() : 0; }
+    int read() override
+    {
+        uint8_t c;
+        return read(&c, 1) ? c : -1;
+    }
+    int read(uint8_t *buf, size_t n)
+    {
+        if (!sock)
+            return 0;
+        n = std::min(n, sock->in.size());
+        memcpy(buf, sock->in.data(), n);
+        sock->in.erase(0, n);
+        return n;
+    }
+    int availableForWrite() { return sock ? (int)sock->room : 0; }
+    uint8_t connected() { return sock && sock->connected; }
+    operator bool() { return sock != nullptr; }
+    void stop()
+    {
+        if (sock)
+            sock->closed = true;
+        sock = nullptr;
+    }
+    void setNoDelay(bool) {}
+    IPAddress remoteIP() { return IPAddress(); }
+};
+
+class WiFiServer
+{
+public:
+    WiFiServer(uint16_t = 80) {}
+    void begin() {}
+    void setNoDelay(bool) {}
+    bool hasClient() { return !mockPending.empty(); }
+    WiFiClient available() { return accept(); }
+    WiFiClient accept()
+    {
+        WiFiClient client;
+        if (!mockPending.empty())
+        {
+            client.sock = mockPending.front();
+            mockPending.pop_front();
+        }
+        return client;
+    }
+};
+
+class WiFiClass
+{
+public:
+    void mode(int) {}
+    IPAddress localIP() { return IPAddress(); }
+    void softAPdisconnect(bool) {}
+};
+
+extern WiFiClass WiFi;
@@ -0,0 +1,11 @@
+// WiFiManager.h — Captive portal mock: always connected
+#pragma once
+
+#include <WiFi.h>
+
+class WiFiManager
+{
+public:
+    bool autoConnect() { return true; }
+    void resetSettings() {}
+};
@@ -0,0 +1,2 @@
+// Wire.h — nothing needed on the host
+#pragma once
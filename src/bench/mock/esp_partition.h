@@ -0,0 +1,32 @@
+// esp_partition.h — No journal partition on the host: the journal stays disabled
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef int esp_err_t;
+#define ESP_OK 0
+
+typedef enum
+{
+    ESP_PARTITION_TYPE_APP = 0,
+    ESP_PARTITION_TYPE_DATA = 1
+} esp_partition_type_t;
+
+typedef enum
+{
+    ESP_PARTITION_SUBTYPE_DATA_SPIFFS = 0x82,
+    ESP_PARTITION_SUBTYPE_ANY = 0xff
+} esp_partition_subtype_t;
+
+typedef struct
+{
+    uint32_t address;
+    uint32_t size;
+    char label[17];
+} esp_partition_t;
+
+inline const esp_partition_t *esp_partition_find_first(esp_partition_type_t, esp_partition_subtype_t, const char *) { return nullptr; }
+inline esp_err_t esp_partition_read(const esp_partition_t *, size_t, void *, size_t) { return ESP_OK; }
+inline esp_err_t esp_partition_write(const esp_partition_t *, size_t, const void *, size_t) { return ESP_OK; }
+inline esp_err_t esp_partition_erase_range(const esp_partition_t *, size_t, size_t) { return ESP_OK; }
@@ -0,0 +1,8 @@
+// esp_wifi.h — MAC override mock
+#pragma once
+
+#include <stdint.h>
+
+#define WIFI_IF_STA 0
+
+inline int esp_wifi_set_mac(int, const uint8_t *) { return 0; }
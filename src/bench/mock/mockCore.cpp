@@ -0,0 +1,58 @@
+// mockCore.cpp — Globals and out-of-line functions behind the host mocks
+
+#include <Arduino.h>
+#include <EEPROM.h>
+#include <SD.h>
+#include <WiFi.h>
+#include <TJpg_Decoder.h>
+
+HardwareSerial Serial, Serial1, Serial2;
+EspClass ESP;
+EEPROMClass EEPROM;
+SDFS SD;
+WiFiClass WiFi;
+TJpg TJpgDec;
+
+int mockUntracked = 0;
+unsigned long mockMillis = 0;
+uint32_t mockMillisStep = 0;
+TaskHandle_t mockCurrentTask = (TaskHandle_t)1;
+std::deque<MockSock *> mockPending;
+
+unsigned long millis()
+{
+    mockMillis += mockMillisStep;
+    return mockMillis;
+}
+
+unsigned long micros()
+{
+    return mockMillis * 1000;
+}
+
+void delay(uint32_t ms)
+{
+    mockMillis += ms;
+}
+
+void delayMicroseconds(uint32_t) {}
+
+int digitalRead(uint8_t)
+{
+    return LOW;
+}
+
+void digitalWrite(uint8_t, uint8_t) {}
+
+void pinMode(uint8_t, uint8_t) {}
+
+char *dtostrf(double value, signed char width, unsigned char prec, char *buf)
+{
+    sprintf(buf, "%*.*f", width, prec, value);
+    return buf;
+}
+
+long map(long x, long inMin, long inMax, long outMin, long outMax)
+{
+    return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
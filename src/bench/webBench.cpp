@@ -0,0 +1,381 @@
+// webBench.cpp — Host benchmark for the web handlers
+// Builds src/main.cpp against the mocks in src/bench/mock (String on std::string, SD in memory,
+// sockets that HttpServer reads and writes) and replays synthetic requests through the real
+// parser, routing and loop() hand-off. For every scenario it reports requests/sec, response bytes,
+// heap allocations and peak heap per request; allocations and peak heap are deterministic, so a
+// saved run works as a regression gate for template and API changes.
+//
+// Build & run:  pio run -e bench && .pio/build/bench/program
+// Options:
+//   --requests N   requests per scenario (default 2000)
+//   --only NAME    run the scenarios whose name contains NAME
+//   --save FILE    write the per-request allocations and peak heap of this run
+//   --check FILE   compare with a saved run: exit 1 when a scenario allocates more often, or its
+//                  peak heap grows by more than 10 %
+
+#include <chrono>
+#include <new>
+#include <vector>
+
+#include "../main.cpp"
+
+// ---------------- Heap accounting ----------------
+// Every operator new goes through here (the String mock's std::string included) unless a mock is
+// storing its own data (UntrackedHeap). The block size sits in front of the block so delete can
+// take it off the live total; untracked blocks carry 0.
+struct HeapCounters
+{
+    size_t allocs;
+    size_t live;
+    size_t peak;
+};
+
+HeapCounters heap;
+
+#define HEAP_HEADER 16 // keeps the returned block max_align_t aligned
+
+void *operator new(size_t n)
+{
+    size_t *block = (size_t *)malloc(n + HEAP_HEADER);
+    if (!block)
+        throw std::bad_alloc();
+    *block = mockUntracked ? 0 : n;
+    if (*block)
+    {
+        heap.allocs++;
+        heap.live += n;
+        if (heap.live > heap.peak)
+            heap.peak = heap.live;
+    }
+    return (uint8_t *)block + HEAP_HEADER;
+}
+
+// GCC inlines this into the standard allocators and then flags free() on a pointer it saw come from
+// operator new (-Wmismatched-new-delete). Here both sides are the malloc pair above, so it is silenced
+// for this function only.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpragmas" // older GCC does not know the warning below
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+void operator delete(void *p) noexcept
+{
+    if (!p)
+        return;
+    size_t *block = (size_t *)((uint8_t *)p - HEAP_HEADER);
+    heap.live -= *block;
+    free(block);
+}
+#pragma GCC diagnostic pop
+
+void *operator new[](size_t n)
+{
+    return operator new(n);
+}
+
+void operator delete[](void *p) noexcept
+{
+    operator delete(p);
+}
+
+// ---------------- Synthetic index.html ----------------
+// The real page lives on the SD card only; this one has every placeholder processor() and the
+// page template know, inside markup of about the same size (~9 KB).
+const char *const pageMotorFields[][2] = {
+    {"VOLTAGE", "Voltage"}, {"CURRENT", "Current"}, {"POWER", "Power"}, {"PF", "Power factor"}, {"UGT", "Source tank"},
+    {"OHT", "Tank"}, {"MODE", "Mode"}, {"REMAIN", "Remaining"}, {"STATUS", "Status"},
+};
+
+const char *const pageSettingFields[][3] = {
+    {"OV", "ov", "Over voltage"}, {"UV", "uv", "Under voltage"}, {"OC", "oc", "Over current"}, {"UC", "uc", "Under current"},
+    {"PF", "pf", "Minimum PF"}, {"OT", "ot", "On time (min)"}, {"FT", "ft", "Off time (min)"}, {"OD", "od", "Power on delay (s)"},
+    {"TW", "tw", "Trip window (s)"},
+};
+
+const char *const pageChecks[][2] = {
+    {"DRYRUN", "dryRun"}, {"VOLTAGE", "voltage"}, {"CURRENT", "current"}, {"CYCLE", "cyclic"},
+};
+
+std::string syntheticPage()
+{
+    std::string page = "<!DOCTYPE html>\n<html>\n<head>\n<meta charset=\"utf-8\">\n"
+                       "<meta name=\"viewport\" content=\"width=device-width, initial-scale=1\">\n"
+                       "<meta http-equiv=\"refresh\" content=\"30\">\n<title>WLC</title>\n<style>\n";
+    for (int i = 0; i < 24; i++)
+        page += "  .c" + std::to_string(i) + " { margin: 4px 0; padding: 2px 8px; border-bottom: 1px solid #ddd; font-family: sans-serif; }\n";
+    page += "</style>\n</head>\n<body>\n<h1>Water Level Controller</h1>\n";
+
+    const char *motors[][3] = {{"BORE", "B", "bore"}, {"SUMP", "S", "sump"}};
+    for (auto &m : motors)
+    {
+        page += std::string("<h2>") + m[2] + " live data</h2>\n<table class=\"c1\">\n";
+        for (auto &f : pageMotorFields)
+            page += std::string("  <tr><td class=\"c2\"><strong>") + f[1] + ":</strong></td><td class=\"c3\">%" + m[0] + "_" + f[0] + "%</td></tr>\n";
+        page += std::string("</table>\n<a href=\"/on?motor=") + m[2] + "\">ON</a> <a href=\"/off?motor=" + m[2] + "\">OFF</a>\n";
+        page += std::string("<form action=\"/settings\" method=\"POST\">\n");
+        for (auto &f : pageSettingFields)
+            page += std::string("  <label class=\"c4\">") + f[2] + " <input type=\"number\" step=\"any\" name=\"" + (char)tolower(m[1][0]) + f[1] + "\" value=\"%" + m[1] + f[0] + "%\"></label>\n";
+        for (auto &c : pageChecks)
+            page += std::string("  <label class=\"c5\"><input type=\"checkbox\" name=\"") + m[2] + c[1] + "\" %" + m[0] + c[0] + "%> " + c[1] + "</label>\n";
+        page += "</form>\n";
+    }
+    page += "<label>Supply budget <input name=\"budget\" value=\"%BUDGET%\"></label>\n"
+            "<label>Aging <input name=\"aging\" value=\"%AGING%\"></label>\n"
+            "<p><a href=\"/restart\">Restart</a></p>\n</body>\n</html>\n";
+    return page;
+}
+
+// ---------------- Requests ----------------
+#define BENCH_HTTP_TASK (TaskHandle_t)1
+#define BENCH_LOOP_TASK (TaskHandle_t)2
+#define BENCH_MAX_PASSES 1000
+#define BENCH_WARMUP 4 // untimed requests first: one-off allocations stay out of the averages
+
+// Runs an accepted socket through HttpServer as httpTask and loop() would; returns the response size
+size_t serve(MockSock &sock)
+{
+    for (int pass = 0; pass < BENCH_MAX_PASSES && !sock.closed; pass++)
+    {
+        mockCurrentTask = BENCH_HTTP_TASK;
+        server.poll();
+        mockCurrentTask = BENCH_LOOP_TASK;
+        serviceWebFromLoop();
+    }
+    mockCurrentTask = BENCH_HTTP_TASK;
+    if (!sock.closed)
+    {
+        fprintf(stderr, "request never finished: %.40s\n", sock.in.c_str());
+        exit(2);
+    }
+    return sock.out.size();
+}
+
+std::string post(const char *path, const char *type, const std::string &body)
+{
+    return std::string("POST ") + path + " HTTP/1.1\r\nHost: wlc\r\nContent-Type: " + type +
+           "\r\nContent-Length: " + std::to_string(body.size()) + "\r\n\r\n" + body;
+}
+
+std::string get(const char *path)
+{
+    return std::string("GET ") + path + " HTTP/1.1\r\nHost: wlc\r\nAccept: */*\r\nUser-Agent: bench\r\n\r\n";
+}
+
+std::vector<String> pageLines;
+
+// processor() alone, over every line of the page: what the SD fallback pays per request
+size_t runProcessor()
+{
+    size_t bytes = 0;
+    for (const String &line : pageLines)
+        bytes += processor(line).length() + 1;
+    return bytes;
+}
+
+std::string requestRoot(unsigned)
+{
+    return get("/");
+}
+
+std::string requestRootLines(unsigned)
+{
+    return get("/bench/lines");
+}
+
+std::string requestOnOff(unsigned i)
+{
+    return get(i & 1 ? "/off?motor=bore" : "/on?motor=bore");
+}
+
+std::string requestSettingsForm(unsigned i)
+{
+    // Every field, as the page posts it; onTime flips so every post changes a byte
+    std::string body = "bov=250&buv=180&boc=6.5&buc=0.3&bpf=0.3&bot=" + std::to_string(5 + (i & 1)) +
+                       "&bft=15&bod=5&btw=3&boredryRun=on&sov=250&suv=180&soc=6.5&suc=0.3&spf=0.3&sot=5&sft=15&sod=5&stw=3"
+                       "&sumpcyclic=on&budget=0&aging=15";
+    return post("/settings", "application/x-www-form-urlencoded", body);
+}
+
+std::string requestStatus(unsigned)
+{
+    mockMillis += STATUS_REFRESH_MS; // rebuilt every time, not served from the 1 s cache
+    return get("/api/status");
+}
+
+std::string requestSettingsGet(unsigned)
+{
+    return get("/api/settings");
+}
+
+std::string requestSettingsPost(unsigned i)
+{
+    return post("/api/settings", "application/json", "{\"bore\":{\"onTime\":" + std::to_string(5 + (i & 1)) + "}}");
+}
+
+struct Scenario
+{
+    const char *name;
+    std::string (*request)(unsigned i); // nullptr: runProcessor()
+};
+
+const Scenario scenarios[] = {
+    {"processor (page lines)", nullptr},
+    {"GET / (compiled)", requestRoot},
+    {"GET / (SD lines)", requestRootLines},
+    {"GET /on, /off", requestOnOff},
+    {"POST /settings", requestSettingsForm},
+    {"GET /api/status", requestStatus},
+    {"GET /api/settings", requestSettingsGet},
+    {"POST /api/settings", requestSettingsPost},
+};
+
+struct Result
+{
+    std::string name;
+    double rate;  // requests/s
+    double bytes; // per request
+    double allocs;
+    size_t peak; // bytes above the live heap at request start, worst request
+};
+
+Result runScenario(const Scenario &s, unsigned requests)
+{
+    Result r = {s.name, 0, 0, 0, 0};
+    size_t bytes = 0, allocs = 0;
+    double seconds = 0;
+    for (unsigned i = 0; i < BENCH_WARMUP + requests; i++)
+    {
+        // The request text and the socket are the client's side: set up before counting
+        MockSock sock;
+        if (s.request)
+        {
+            UntrackedHeap untracked;
+            sock.in = s.request(i);
+            mockAccept(&sock);
+        }
+
+        size_t liveBefore = heap.live, allocsBefore = heap.allocs;
+        heap.peak = heap.live;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        size_t n = s.request ? serve(sock) : runProcessor();
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (i < BENCH_WARMUP)
+            continue;
+
+        seconds += elapsed;
+        bytes += n;
+        allocs += heap.allocs - allocsBefore;
+        if (heap.peak - liveBefore > r.peak)
+            r.peak = heap.peak - liveBefore;
+    }
+    r.rate = seconds > 0 ? requests / seconds : 0;
+    r.bytes = (double)bytes / requests;
+    r.allocs = (double)allocs / requests;
+    return r;
+}
+
+// ---------------- Regression gate ----------------
+// One line per scenario: allocations per request, peak heap, then the name
+bool saveResults(const char *path, const std::vector<Result> &results)
+{
+    FILE *f = fopen(path, "w");
+    if (!f)
+        return false;
+    for (const Result &r : results)
+        fprintf(f, "%.2f %zu %s\n", r.allocs, r.peak, r.name.c_str());
+    fclose(f);
+    return true;
+}
+
+int checkResults(const char *path, const std::vector<Result> &results)
+{
+    FILE *f = fopen(path, "r");
+    if (!f)
+    {
+        fprintf(stderr, "cannot read %s\n", path);
+        return 2;
+    }
+    int failures = 0;
+    double allocs;
+    size_t peak;
+    char name[64];
+    while (fscanf(f, "%lf %zu %63[^\n]\n", &allocs, &peak, name) == 3)
+    {
+        for (const Result &r : results)
+        {
+            if (r.name != name)
+                continue;
+            if (r.allocs > allocs + 0.005)
+            {
+                printf("REGRESSION %s: %.2f allocations per request, was %.2f\n", name, r.allocs, allocs);
+                failures++;
+            }
+            if (r.peak > peak + peak / 10)
+            {
+                printf("REGRESSION %s: peak heap %zu B, was %zu B\n", name, r.peak, peak);
+                failures++;
+            }
+        }
+    }
+    fclose(f);
+    if (failures)
+        printf("%d regression(s) against %s\n", failures, path);
+    else
+        printf("no regression against %s\n", path);
+    return failures ? 1 : 0;
+}
+
+int main(int argc, char **argv)
+{
+    unsigned requests = 2000;
+    const char *only = nullptr, *savePath = nullptr, *checkPath = nullptr;
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "--requests") && i + 1 < argc)
+            requests = strtoul(argv[++i], nullptr, 10);
+        else if (!strcmp(argv[i], "--only") && i + 1 < argc)
+            only = argv[++i];
+        else if (!strcmp(argv[i], "--save") && i + 1 < argc)
+            savePath = argv[++i];
+        else if (!strcmp(argv[i], "--check") && i + 1 < argc)
+            checkPath = argv[++i];
+        else
+        {
+            fprintf(stderr, "usage: %s [--requests N] [--only NAME] [--save FILE] [--check FILE]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (!requests)
+        requests = 1;
+
+    std::string page = syntheticPage();
+    fs::mockFiles()[PAGE_FILE] = page;
+    for (size_t from = 0, to; from < page.size(); from = to + 1)
+    {
+        to = page.find('\n', from);
+        pageLines.push_back(String(page.substr(from, to - from)));
+    }
+
+    setup(); // same routes, page template and settings as the target
+    server.on("/bench/lines", handleRootLines, true);
+    mockMillis += 60000; // past PowerOnDelay
+    publishControllerView();
+
+    printf("%u requests per scenario, %zu B page with %zu lines\n\n", requests, page.size(), pageLines.size());
+    printf("%-24s %12s %12s %12s %12s\n", "scenario", "req/s", "bytes/req", "allocs/req", "peak heap");
+    std::vector<Result> results;
+    for (const Scenario &s : scenarios)
+    {
+        if (only && !strstr(s.name, only))
+            continue;
+        Result r = runScenario(s, requests);
+        printf("%-24s %12.0f %12.0f %12.2f %10zu B\n", r.name.c_str(), r.rate, r.bytes, r.allocs, r.peak);
+        results.push_back(r);
+    }
+    printf("\nEEPROM commits: %zu\n", EEPROM.commits);
+
+    if (savePath && !saveResults(savePath, results))
+    {
+        fprintf(stderr, "cannot write %s\n", savePath);
+        return 2;
+    }
+    return checkPath ? checkResults(checkPath, results) : 0;
+}
@@ -0,0 +1,840 @@
+// wlcSim.cpp — Host time-warp simulator for the BORE + SUMP control logic
+// Runs include/motorControl.cpp against simulated tanks, float switches and a PZEM stand-in
+// with a virtual millis() clock, so weeks of cyclic timer behaviour replay in seconds.
+//
+// Build & run:  pio run -e native && .pio/build/native/program --days 14 --set bore.cyclicTimer=1
+// Options:
+//   --days N          simulated days (default 7)
+//   --step MS         simulated ms per loop() pass (default 50)
+//   --start-ms MS     initial millis() value, e.g. 4294000000 to cross the 49.7 day wrap
+//   --seed N          RNG seed for supply/usage noise
+//   --set a.b=value   override a setting, e.g. sump.offTime=20, bore.detectCurrent=1,
+//                     supply.currentBudget=9 (two pumps together), supply.agingMinutes=5
+//   --slosh P         chance per 10 ms sample that a float near its mark bounces (default 0.3)
+//   --trace           print every control log line with its simulated timestamp
+//   --journal-sectors N  size of the simulated flash journal partition (default 8 x 4 KB, so a week
+//                     rotates it); the report reboots on it and checks what recovery restores
+//   --telemetry-blocks N  size of the in-memory telemetry store in 4 KB blocks (default 64, so a
+//                     week wraps it); the report decodes it back and checks every sample
+//   --bench-modbus N  run N bulk PZEM transactions against the fake serial device and report frames/sec
+//   --stress-snapshot S  hammer PzemSnapshot with one writer and several reader threads for S
+//                        seconds and report any torn reading (exit code 1 if one is seen)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <array>
+
+#include <pzemModbus.h>
+#include <motorControl.cpp>
+#include <telemetry.cpp>
+
+// ---------------- Simulated plant ----------------
+struct Tank
+{
+    float capacity; // litres
+    float level;    // litres
+    float fullMark; // float switch flips to 1 (FULL) at or above this fraction
+    float lowMark;  // float switch flips back to 0 (LOW) below this fraction
+    bool floatUp;   // current float switch state (mechanical hysteresis)
+};
+
+struct Pump
+{
+    uint8_t relayPin;
+    bool relay;
+    float flowLpm;  // litres per minute when running wet
+    float amps;     // running current
+    float pfRun;    // power factor when pumping
+    float dryAmps;  // current when running dry
+    float dryPF;    // power factor when running dry
+    unsigned long starts;
+    double runSeconds;
+};
+
+Tank boreOHT = {2000, 1200, 0.95f, 0.30f, false};
+Tank sumpUGT = {6000, 3000, 0.90f, 0.10f, true};
+Tank sumpOHT = {1500, 900, 0.95f, 0.30f, false};
+
+Pump borePump = {BORE_MOTOR_RELAY_PIN, false, 45, 5.2f, 0.82f, 1.6f, 0.35f, 0, 0};
+Pump sumpPump = {SUMP_MOTOR_RELAY_PIN, false, 60, 3.1f, 0.78f, 1.1f, 0.30f, 0, 0};
+
+uint32_t simMillis = 0;
+uint64_t simElapsedMs = 0;
+bool traceLog = false;
+double energyKWh = 0;
+unsigned long trips[7] = {0};
+double boreOHTEmptySec = 0, sumpOHTEmptySec = 0;
+float floatSlosh = 0.3f;
+unsigned long floatChanges = 0; // stable level changes seen by the control logic
+double overlapSec = 0;           // time with more than one pump running
+double maxQueuedSec[MOTOR_COUNT] = {};
+
+float frand()
+{
+    return (float)rand() / (float)RAND_MAX;
+}
+
+void updateFloat(Tank &t)
+{
+    float frac = t.level / t.capacity;
+    if (!t.floatUp && frac >= t.fullMark)
+        t.floatUp = true;
+    else if (t.floatUp && frac < t.lowMark)
+        t.floatUp = false;
+}
+
+// Household draw in litres per minute, with morning and evening peaks
+float demandLpm(double hourOfDay, float peak)
+{
+    if ((hourOfDay >= 6 && hourOfDay < 9) || (hourOfDay >= 18 && hourOfDay < 21))
+        return peak * (0.7f + 0.6f * frand());
+    if (hourOfDay >= 23 || hourOfDay < 5)
+        return peak * 0.05f;
+    return peak * 0.25f * frand();
+}
+
+void stepPlant(double dtSec)
+{
+    double hour = fmod(simElapsedMs / 3600000.0, 24.0);
+    double dtMin = dtSec / 60.0;
+
+    // Municipal supply fills the UGT for two hours every morning
+    if (hour >= 5 && hour < 7)
+        sumpUGT.level += 40 * dtMin;
+
+    if (borePump.relay)
+        boreOHT.level += borePump.flowLpm * dtMin;
+    if (sumpPump.relay && sumpUGT.level > 0)
+    {
+        float moved = fminf(sumpPump.flowLpm * dtMin, sumpUGT.level);
+        sumpUGT.level -= moved;
+        sumpOHT.level += moved;
+    }
+
+    boreOHT.level -= demandLpm(hour, 12) * dtMin;
+    sumpOHT.level -= demandLpm(hour, 8) * dtMin;
+
+    Tank *tanks[] = {&boreOHT, &sumpUGT, &sumpOHT};
+    for (Tank *t : tanks)
+    {
+        t->level = fmaxf(0, fminf(t->capacity, t->level));
+        updateFloat(*t);
+    }
+
+    if (boreOHT.level <= 0)
+        boreOHTEmptySec += dtSec;
+    if (sumpOHT.level <= 0)
+        sumpOHTEmptySec += dtSec;
+    if (borePump.relay)
+        borePump.runSeconds += dtSec;
+    if (sumpPump.relay)
+        sumpPump.runSeconds += dtSec;
+}
+
+// ---------------- ControlIO for the simulator ----------------
+uint32_t simNow()
+{
+    return simMillis;
+}
+
+// Raw contact of a float: within 2 % of either mark the water surface rocks the float and the
+// contact bounces with probability floatSlosh per sample
+bool rawFloat(const Tank &t)
+{
+    float frac = t.level / t.capacity;
+    bool near = fabsf(frac - t.fullMark) < 0.02f || fabsf(frac - t.lowMark) < 0.02f;
+    return (near && frand() < floatSlosh) ? !t.floatUp : t.floatUp;
+}
+
+// What the timer ISR reads from GPIO_IN_REG
+uint32_t simFloatGpio()
+{
+    uint32_t in = 0;
+    if (rawFloat(boreOHT))
+        in |= 1UL << FLOAT_BORE_OHT_PIN;
+    if (rawFloat(sumpUGT))
+        in |= 1UL << FLOAT_SUMP_UGT_PIN;
+    if (rawFloat(sumpOHT))
+        in |= 1UL << FLOAT_SUMP_OHT_PIN;
+    return in;
+}
+
+void simWritePin(uint8_t pin, uint8_t level)
+{
+    Pump *p = (pin == borePump.relayPin) ? &borePump : (pin == sumpPump.relayPin) ? &sumpPump
+                                                                                    : nullptr;
+    if (!p)
+        return;
+    if (level && !p->relay)
+        p->starts++;
+    p->relay = level;
+}
+
+// ---------------- Fake PZEM-004T meters on a serial bus ----------------
+// Each meter answers Modbus "read input registers" requests for its own address (or the general
+// address when it is alone on the bus) from values the simulator sets, quantised exactly like the
+// meter (0.1 V, 1 mA, 0.1 W, 1 Wh, 0.1 Hz, 0.01 PF). Replies appear after their 9600 baud wire time.
+struct FakePzemMeter
+{
+    uint8_t address;
+    float voltage, current, power, frequency, pf;
+    double energyWh;
+};
+
+class FakePzemSerial
+{
+public:
+    uint32_t replyDelayMs = 34; // 8 byte request + 25 byte reply at 9600 8N1
+    unsigned long requests = 0, badRequests = 0;
+
+    void attach(FakePzemMeter &m)
+    {
+        if (_count < 8)
+            _meters[_count++] = &m;
+    }
+
+    size_t write(const uint8_t *buf, size_t len)
+    {
+        for (size_t i = 0; i < len; i++)
+        {
+            if (_reqLen < sizeof(_req))
+                _req[_reqLen++] = buf[i];
+            if (_reqLen == PZEM_REQUEST_LEN)
+                answer();
+        }
+        return len;
+    }
+
+    int available()
+    {
+        if (simNow() - _replyAt < replyDelayMs)
+            return 0;
+        return (int)(_txLen - _txPos);
+    }
+
+    int read()
+    {
+        return available() ? _tx[_txPos++] : -1;
+    }
+
+private:
+    FakePzemMeter *_meters[8];
+    uint8_t _count = 0;
+    uint8_t _req[PZEM_REQUEST_LEN];
+    size_t _reqLen = 0;
+    uint8_t _tx[PZEM_RESPONSE_LEN];
+    size_t _txLen = 0, _txPos = 0;
+    uint32_t _replyAt = 0;
+
+    void answer()
+    {
+        _reqLen = 0;
+        _txLen = _txPos = 0;
+        requests++;
+        FakePzemMeter *m = nullptr;
+        for (uint8_t i = 0; i < _count; i++)
+            if (_req[0] == _meters[i]->address || (_req[0] == PZEM_GENERAL_ADDR && _count == 1))
+                m = _meters[i];
+        uint16_t crc = pzemCrc16(_req, 6);
+        if (!m || _req[1] != PZEM_CMD_READ_INPUT || _req[6] != (crc & 0xFF) || _req[7] != (crc >> 8) ||
+            _req[5] != PZEM_REG_COUNT)
+        {
+            badRequests++;
+            return; // a real meter stays silent
+        }
+
+        uint32_t regs[PZEM_REG_COUNT];
+        uint32_t mA = (uint32_t)lroundf(m->current * 1000), dW = (uint32_t)lroundf(m->power * 10), wh = (uint32_t)m->energyWh;
+        regs[0] = (uint32_t)lroundf(m->voltage * 10);
+        regs[1] = mA & 0xFFFF;
+        regs[2] = mA >> 16;
+        regs[3] = dW & 0xFFFF;
+        regs[4] = dW >> 16;
+        regs[5] = wh & 0xFFFF;
+        regs[6] = wh >> 16;
+        regs[7] = (uint32_t)lroundf(m->frequency * 10);
+        regs[8] = (uint32_t)lroundf(m->pf * 100);
+        regs[9] = 0;
+
+        _tx[0] = m->address;
+        _tx[1] = PZEM_CMD_READ_INPUT;
+        _tx[2] = 2 * PZEM_REG_COUNT;
+        for (int i = 0; i < PZEM_REG_COUNT; i++)
+        {
+            _tx[3 + 2 * i] = regs[i] >> 8;
+            _tx[4 + 2 * i] = regs[i] & 0xFF;
+        }
+        crc = pzemCrc16(_tx, PZEM_RESPONSE_LEN - 2);
+        _tx[PZEM_RESPONSE_LEN - 2] = crc & 0xFF;
+        _tx[PZEM_RESPONSE_LEN - 1] = crc >> 8;
+        _txLen = PZEM_RESPONSE_LEN;
+        _replyAt = simNow();
+    }
+};
+
+FakePzemSerial fakeBus;
+FakePzemMeter fakeMeters[PZEM_CHANNELS]; // addresses from pzemAddress, set in main()
+PzemPoller<FakePzemSerial, PZEM_CHANNELS> pzemBus(fakeBus, pzemAddress, publishMeter);
+
+// Electrical stand-in: every motor's meter sees the shared supply voltage and its own pump
+void simUpdatePzem(double dtSec)
+{
+    double hour = fmod(simElapsedMs / 3600000.0, 24.0);
+    float v = 228 + 8 * sinf((float)(hour / 24.0 * 2 * M_PI)) + 3 * (frand() - 0.5f);
+    if (frand() < 0.002f)
+        v -= 50; // occasional supply dip
+
+    for (FakePzemMeter &m : fakeMeters)
+    {
+        m.voltage = v;
+        m.current = 0;
+        m.pf = 0;
+    }
+    Pump *pumps[] = {&borePump, &sumpPump};
+    for (int k = 0; k < 2; k++)
+    {
+        Pump *p = pumps[k];
+        if (!p->relay)
+            continue;
+        FakePzemMeter &m = fakeMeters[motorPins[k].meter];
+        bool dry = (p == &sumpPump) && sumpUGT.level <= 0;
+        m.current += (dry ? p->dryAmps : p->amps) * (0.97f + 0.06f * frand());
+        m.pf = m.pf > 0 ? (m.pf + (dry ? p->dryPF : p->pfRun)) / 2 : (dry ? p->dryPF : p->pfRun);
+    }
+    energyKWh = 0;
+    for (FakePzemMeter &m : fakeMeters)
+    {
+        m.power = m.voltage * m.current * m.pf;
+        m.energyWh += m.power * dtSec / 3600.0;
+        energyKWh += m.energyWh / 1000.0;
+    }
+}
+
+void simLog(const char *fmt, ...)
+{
+    if (!traceLog)
+        return;
+    unsigned long sec = (unsigned long)(simElapsedMs / 1000);
+    printf("[d%lu %02lu:%02lu:%02lu] ", sec / 86400, (sec / 3600) % 24, (sec / 60) % 60, sec % 60);
+    va_list args;
+    va_start(args, fmt);
+    vprintf(fmt, args);
+    va_end(args);
+}
+
+// ---------------- Journal ----------------
+// NOR flash stand-in: erase sets 0xFF, programming can only clear bits
+struct FlashSim
+{
+    std::vector<uint8_t> bytes;
+    unsigned long erases = 0;
+    size_t tearNextWrite = 0; // program only this many bytes of the next write (power cut)
+
+    bool read(uint32_t offset, void *buf, size_t len)
+    {
+        if (offset + len > bytes.size())
+            return false;
+        memcpy(buf, &bytes[offset], len);
+        return true;
+    }
+
+    bool write(uint32_t offset, const void *buf, size_t len)
+    {
+        if (offset + len > bytes.size())
+            return false;
+        if (tearNextWrite)
+        {
+            len = tearNextWrite;
+            tearNextWrite = 0;
+        }
+        for (size_t i = 0; i < len; i++)
+            bytes[offset + i] &= ((const uint8_t *)buf)[i];
+        return true;
+    }
+
+    bool erase(uint32_t offset, size_t len)
+    {
+        if (offset + len > bytes.size())
+            return false;
+        memset(&bytes[offset], 0xFF, len);
+        erases++;
+        return true;
+    }
+};
+
+#define SIM_EPOCH 1700000000 // telemetry and journal timestamps start here
+
+FlashSim journalFlash;
+EventJournal<FlashSim> *journal = nullptr;
+unsigned long journalRecords = 0;
+
+void simJournal(const JournalRecord &record)
+{
+    if (!journal)
+        return;
+    JournalRecord r = record;
+    r.time = SIM_EPOCH + (uint32_t)(simElapsedMs / 1000);
+    journal->append(r);
+    journalRecords++;
+    if (journal->checkpointDue())
+        journalCheckpoint();
+}
+
+ControlIO io = {simNow, simWritePin, simLog, simJournal};
+
+// ---------------- Settings overrides ----------------
+bool applySetting(const char *arg)
+{
+    char key[32];
+    const char *eq = strchr(arg, '=');
+    const char *dot = strchr(arg, '.');
+    if (!eq || !dot || dot > eq || (size_t)(eq - dot - 1) >= sizeof(key))
+        return false;
+    if (!strncmp(arg, "supply.", 7))
+    {
+        if (!strncmp(dot + 1, "currentBudget=", 14))
+            supplySettings.currentBudget = atof(eq + 1);
+        else if (!strncmp(dot + 1, "agingMinutes=", 13) && atoi(eq + 1) >= 1)
+            supplySettings.agingMinutes = atoi(eq + 1);
+        else
+            return false;
+        return true;
+    }
+    Settings *s = !strncmp(arg, "bore.", 5) ? &boreSettings : !strncmp(arg, "sump.", 5) ? &sumpSettings
+                                                                                        : nullptr;
+    if (!s)
+        return false;
+    memcpy(key, dot + 1, eq - dot - 1);
+    key[eq - dot - 1] = '\0';
+    const char *val = eq + 1;
+
+    if (!strcmp(key, "overVoltage"))
+        s->overVoltage = atof(val);
+    else if (!strcmp(key, "underVoltage"))
+        s->underVoltage = atof(val);
+    else if (!strcmp(key, "overCurrent"))
+        s->overCurrent = atof(val);
+    else if (!strcmp(key, "underCurrent"))
+        s->underCurrent = atof(val);
+    else if (!strcmp(key, "minPF"))
+        s->minPF = atof(val);
+    else if (!strcmp(key, "PowerOnDelay"))
+        s->PowerOnDelay = atoi(val);
+    else if (!strcmp(key, "onTime"))
+        s->onTime = atoi(val);
+    else if (!strcmp(key, "offTime"))
+        s->offTime = atoi(val);
+    else if (!strcmp(key, "dryRun"))
+        s->dryRun = atoi(val);
+    else if (!strcmp(key, "detectVoltage"))
+        s->detectVoltage = atoi(val);
+    else if (!strcmp(key, "detectCurrent"))
+        s->detectCurrent = atoi(val);
+    else if (!strcmp(key, "cyclicTimer"))
+        s->cyclicTimer = atoi(val);
+    else if (!strcmp(key, "tripWindow"))
+        s->tripWindow = atoi(val);
+    else
+        return false;
+    return true;
+}
+
+void printReport(double days, double wallSec)
+{
+    printf("---- Simulated %.1f days in %.2f s (%.0fx real time) ----\n", days, wallSec, days * 86400.0 / wallSec);
+    printf("Bore : %lu starts, %.1f h running, OHT empty %.1f h\n", borePump.starts, borePump.runSeconds / 3600, boreOHTEmptySec / 3600);
+    printf("Sump : %lu starts, %.1f h running, OHT empty %.1f h\n", sumpPump.starts, sumpPump.runSeconds / 3600, sumpOHTEmptySec / 3600);
+    printf("Trips: OV/UV %lu, OC %lu, UC %lu, Dry run %lu\n", trips[3], trips[4], trips[5], trips[6]);
+    printf("Floats: %lu stable changes (slosh %.2f)\n", floatChanges, floatSlosh);
+    printf("Queue: budget %.1f A, %.1f h with pumps overlapping, longest wait", supplySettings.currentBudget, overlapSec / 3600);
+    for (uint8_t k = 0; k < MOTOR_COUNT; k++)
+        printf(" %s %.0f min", motorPins[k].name, maxQueuedSec[k] / 60);
+    printf("\n");
+    printf("Energy: %.2f kWh", energyKWh);
+    if (PZEM_CHANNELS > 1)
+        printf(" (bore %.2f, sump %.2f)", fakeMeters[motorPins[MOTOR_BORE].meter].energyWh / 1000, fakeMeters[motorPins[MOTOR_SUMP].meter].energyWh / 1000);
+    printf("\n");
+    for (uint8_t ch = 0; ch < PZEM_CHANNELS; ch++)
+    {
+        const auto &st = pzemBus.stats(ch);
+        printf("PZEM 0x%02X: %u frames, %u timeouts, %u errors\n", pzemAddress[ch], st.frames, st.timeouts, st.errors);
+    }
+}
+
+// ---------------- Telemetry ----------------
+// The SD file stand-in: a byte vector that grows on write like a FAT file
+struct RamStorage
+{
+    std::vector<uint8_t> bytes;
+    unsigned long reads = 0;
+
+    bool read(uint32_t offset, void *buf, size_t len)
+    {
+        reads++;
+        if (offset + len > bytes.size())
+            return false;
+        memcpy(buf, &bytes[offset], len);
+        return true;
+    }
+
+    bool write(uint32_t offset, const void *buf, size_t len)
+    {
+        if (offset + len > bytes.size())
+            bytes.resize(offset + len);
+        memcpy(&bytes[offset], buf, len);
+        return true;
+    }
+};
+
+typedef TelemetryStore<RamStorage, TELEMETRY_FIELDS> SimTelemetry;
+typedef std::pair<uint32_t, std::array<int32_t, TELEMETRY_FIELDS>> TelemetryRow;
+
+// Decode everything still held and compare with what was appended, then remount like a reboot
+// and check seeks land on the right sample. Returns the number of mismatches.
+unsigned long checkTelemetry(SimTelemetry &store, RamStorage &ram, const std::vector<TelemetryRow> &written)
+{
+    static uint8_t buf[TELEMETRY_BLOCK_SIZE];
+    unsigned long bad = 0, decoded = 0;
+    store.flush();
+
+    size_t first = 0;
+    while (first < written.size() && written[first].first < store.firstTime())
+        first++;
+    SimTelemetry::Cursor cur(store, buf);
+    uint32_t t;
+    int32_t v[TELEMETRY_FIELDS];
+    if (cur.seek(store.firstTime()))
+        while (cur.next(t, v))
+        {
+            size_t i = first + decoded++;
+            if (i >= written.size() || t != written[i].first || memcmp(v, written[i].second.data(), sizeof(v)))
+                bad++;
+        }
+    if (first + decoded != written.size())
+        bad++;
+
+    SimTelemetry remounted(ram, store.blockCount());
+    remounted.begin();
+    if (remounted.usedBlocks() != store.usedBlocks() || remounted.lastTime() != store.lastTime())
+        bad++;
+
+    unsigned long seekReads = 0;
+    const int seeks = 1000;
+    for (int k = 0; k < seeks && decoded; k++)
+    {
+        size_t i = first + (size_t)rand() % decoded;
+        SimTelemetry::Cursor c(remounted, buf);
+        unsigned long r0 = ram.reads;
+        if (!c.seek(written[i].first) || !c.next(t, v) || t != written[i].first)
+            bad++;
+        seekReads += ram.reads - r0;
+    }
+
+    double span = decoded ? (store.lastTime() - store.firstTime()) / 86400.0 : 0;
+    printf("Telemetry: %zu samples, %.2f bytes/sample, %u/%u blocks, %.1f days held, %lu storage reads/seek, %lu mismatches\n",
+           written.size(), written.empty() ? 0 : (double)store.appendedBytes() / written.size(), (unsigned)store.usedBlocks(),
+           (unsigned)store.blockCount(), span, decoded ? seekReads / seeks : 0, bad);
+    return bad;
+}
+
+// Reboot on the journal as it is now: the recovered off timers must match the live ones to within
+// the heartbeat interval (the virtual clock stops at the newest record), powerFailed must be set
+// exactly when a motor was running. Then tear a record in half and check the journal still mounts,
+// replays and appends. Returns the number of mismatches.
+unsigned long checkJournal(uint32_t heartbeatMs)
+{
+    unsigned long bad = 0;
+    bool wasRunning = anyMotorRunning();
+    uint32_t liveOff[MOTOR_COUNT];
+    for (uint8_t k = 0; k < MOTOR_COUNT; k++)
+        liveOff[k] = motors[k].lastOffTime;
+
+    EventJournal<FlashSim> rebooted(journalFlash, journal->sectors());
+    rebooted.begin();
+    if (rebooted.nextSeq() != journal->nextSeq())
+        bad++;
+    recovery = JournalRecovery();
+    traceLog = false;
+    rebooted.replay(recoverRecord);
+    finishRecovery();
+    if (powerFailed != wasRunning)
+        bad++;
+    for (uint8_t k = 0; k < MOTOR_COUNT; k++)
+        if (!wasRunning && liveOff[k] && motors[k].lastOffTime - liveOff[k] > heartbeatMs)
+            bad++;
+
+    // Brownout halfway through programming the next slot: the torn slot is skipped, the next
+    // record goes after it and still gets the following sequence number
+    uint32_t before = rebooted.nextSeq();
+    journal = &rebooted;
+    journalFlash.tearNextWrite = sizeof(JournalRecord) / 2;
+    journalEvent(EV_HEARTBEAT, 0);
+    EventJournal<FlashSim> again(journalFlash, rebooted.sectors());
+    again.begin();
+    journal = &again;
+    journalEvent(EV_BOOT, 0);
+    uint32_t lastSeq = 0, lastType = 0;
+    again.replay([&](const JournalRecord &r)
+                 { lastSeq = r.seq; lastType = r.type; });
+    if (again.nextSeq() != before + 1 || lastSeq != before || lastType != EV_BOOT)
+        bad++;
+
+    printf("Journal: %lu records, %lu sector erases over %u sectors, recovery %s (powerFailed=%d)\n",
+           journalRecords, journalFlash.erases, (unsigned)rebooted.sectors(), bad ? "MISMATCH" : "ok", wasRunning);
+    return bad;
+}
+
+// ---------------- Seqlock stress ----------------
+// The writer publishes fields that are all derived from one counter, so any reader copy that
+// mixes two publishes breaks the relation and is counted as torn.
+int stressSnapshot(double seconds)
+{
+    PzemSnapshot snap;
+    std::atomic<bool> stop{false};
+    std::atomic<unsigned long long> reads{0}, retries{0}, torn{0};
+    unsigned long long published = 0;
+
+    unsigned readers = std::thread::hardware_concurrency();
+    readers = readers > 2 ? readers - 1 : 2;
+    std::vector<std::thread> pool;
+    for (unsigned t = 0; t < readers; t++)
+    {
+        pool.emplace_back([&]()
+                          {
+            unsigned long long n = 0, miss = 0, bad = 0;
+            uint32_t lastSeq = 0;
+            PzemReading r;
+            while (!stop.load(std::memory_order_relaxed))
+            {
+                if (!snap.tryRead(r))
+                {
+                    miss++;
+                    continue;
+                }
+                if (r.seq == 0)
+                    continue; // nothing published yet
+                n++;
+                float k = r.voltage;
+                if (r.current != k + 1 || r.power != k + 2 || r.energy != k + 3 || r.pf != k + 4 ||
+                    r.timestamp != (uint32_t)k || r.seq < lastSeq)
+                    bad++;
+                lastSeq = r.seq;
+            }
+            reads += n;
+            retries += miss;
+            torn += bad; });
+    }
+
+    clock_t wallStart = clock();
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::duration<double>(seconds);
+    while (std::chrono::steady_clock::now() < deadline)
+    {
+        for (int burst = 0; burst < 1000; burst++)
+        {
+            float k = (float)(published++ & 0xFFFFF); // exact in a float
+            snap.publish(k, k + 1, k + 2, k + 3, k + 4, (uint32_t)k);
+        }
+    }
+    stop = true;
+    for (std::thread &t : pool)
+        t.join();
+
+    printf("---- PzemSnapshot stress: %u readers, %.1f s (%.1f s CPU) ----\n", readers, seconds, (double)(clock() - wallStart) / CLOCKS_PER_SEC);
+    printf("Publishes: %llu, reads: %llu, retried reads: %llu, torn reads: %llu\n",
+           published, reads.load(), retries.load(), torn.load());
+    return torn.load() ? 1 : 0;
+}
+
+// ---------------- Modbus benchmark ----------------
+// Host CPU cost of encode + CRC + decode per frame, plus the 9600 8N1 wire budget for one bulk
+// read versus one transaction per quantity (V, I, P, E, PF).
+int benchModbus(long frames)
+{
+    FakePzemMeter meter = {PZEM_GENERAL_ADDR, 231.4f, 5.123f, 972.5f, 50, 0.82f, 123456};
+    FakePzemSerial port;
+    port.replyDelayMs = 0; // host cost only; wire time is computed below
+    port.attach(meter);
+
+    PzemFrame frame;
+    long ok = 0;
+    clock_t wallStart = clock();
+    for (long n = 0; n < frames; n++)
+    {
+        meter.current = 5 + (n & 0xFF) / 1000.0f;
+        if (pzemReadAll(port, PZEM_GENERAL_ADDR, frame, simNow) && fabsf(frame.current - meter.current) < 0.0006f)
+            ok++;
+    }
+    double sec = (double)(clock() - wallStart) / CLOCKS_PER_SEC;
+
+    const double byteMs = 10 * 1000.0 / 9600; // start + 8 data + stop bits
+    int bulkBytes = PZEM_REQUEST_LEN + PZEM_RESPONSE_LEN;
+    int splitBytes = 5 * PZEM_REQUEST_LEN + 2 * (5 + 2) + 3 * (5 + 4); // V, PF: 1 register; I, P, E: 2 registers
+    printf("---- PZEM bulk read benchmark: %ld frames ----\n", frames);
+    printf("Host decode: %.0f frames/s, %ld valid, %lu bad requests\n", frames / (sec > 0 ? sec : 1e-9), ok, port.badRequests);
+    printf("Wire @9600: bulk %d bytes = %.1f ms (max %.1f frames/s), per-quantity %d bytes = %.1f ms (max %.1f frames/s)\n",
+           bulkBytes, bulkBytes * byteMs, 1000 / (bulkBytes * byteMs), splitBytes, splitBytes * byteMs, 1000 / (splitBytes * byteMs));
+    return ok == frames ? 0 : 1;
+}
+
+int main(int argc, char **argv)
+{
+    double days = 7;
+    uint32_t stepMs = 50;
+    uint32_t telemetryBlocks = 64;
+    uint32_t journalSectors = 8;
+    unsigned seed = 1;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "--days") && i + 1 < argc)
+            days = atof(argv[++i]);
+        else if (!strcmp(argv[i], "--step") && i + 1 < argc)
+            stepMs = (uint32_t)atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--start-ms") && i + 1 < argc)
+            simMillis = (uint32_t)strtoul(argv[++i], nullptr, 10);
+        else if (!strcmp(argv[i], "--seed") && i + 1 < argc)
+            seed = (unsigned)atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--set") && i + 1 < argc)
+        {
+            if (!applySetting(argv[++i]))
+            {
+                fprintf(stderr, "Unknown setting: %s\n", argv[i]);
+                return 1;
+            }
+        }
+        else if (!strcmp(argv[i], "--slosh") && i + 1 < argc)
+            floatSlosh = atof(argv[++i]);
+        else if (!strcmp(argv[i], "--trace"))
+            traceLog = true;
+        else if (!strcmp(argv[i], "--telemetry-blocks") && i + 1 < argc)
+            telemetryBlocks = (uint32_t)atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--journal-sectors") && i + 1 < argc)
+            journalSectors = (uint32_t)atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--bench-modbus") && i + 1 < argc)
+            return benchModbus(atol(argv[++i]));
+        else if (!strcmp(argv[i], "--stress-snapshot") && i + 1 < argc)
+            return stressSnapshot(atof(argv[++i]));
+        else
+        {
+            fprintf(stderr, "usage: %s [--days N] [--step MS] [--start-ms MS] [--seed N] [--set bore|sump|supply.field=value] [--slosh P] [--trace] [--telemetry-blocks N] [--journal-sectors N] [--bench-modbus N] [--stress-snapshot S]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (stepMs == 0)
+        stepMs = 1;
+    srand(seed);
+
+    const uint64_t endMs = (uint64_t)(days * 86400000.0);
+    int lastError[MOTOR_COUNT] = {};
+    uint64_t queuedSince[MOTOR_COUNT] = {};
+    bool wasQueued[MOTOR_COUNT] = {};
+    RamStorage telemetryRam;
+    SimTelemetry telemetry(telemetryRam, telemetryBlocks ? telemetryBlocks : 1);
+    telemetry.begin();
+    std::vector<TelemetryRow> telemetryRows;
+    const uint32_t epoch = SIM_EPOCH;
+    const uint32_t heartbeatMs = 300000; // JOURNAL_HEARTBEAT_S on target
+    uint64_t lastHeartbeat = 0;
+
+    // Fresh flash, then boot the way setup() does
+    journalFlash.bytes.assign((journalSectors < 2 ? 2 : journalSectors) * JOURNAL_SECTOR_SIZE, 0xFF);
+    EventJournal<FlashSim> bootJournal(journalFlash, journalFlash.bytes.size() / JOURNAL_SECTOR_SIZE);
+    bootJournal.begin();
+    bootJournal.replay(recoverRecord);
+    finishRecovery();
+    journal = &bootJournal;
+    journalEvent(EV_BOOT, 0);
+    uint64_t lastSampleSec = ~0ULL;
+    clock_t wallStart = clock();
+
+    for (uint8_t ch = 0; ch < PZEM_CHANNELS; ch++)
+    {
+        fakeMeters[ch] = {pzemAddress[ch], 0, 0, 0, 50, 0, 0};
+        fakeBus.attach(fakeMeters[ch]);
+    }
+    floatInputs.prime(simFloatGpio(), simNow());
+    uint32_t floatLevels = floatInputs.levels(), floatDue = 0;
+
+    while (simElapsedMs < endMs)
+    {
+        // Meters see the plant as it is at the start of this loop() pass
+        simUpdatePzem(stepMs / 1000.0);
+
+        // loop(): AUTO switch position
+        autoControlTick();
+
+        for (uint8_t k = 0; k < MOTOR_COUNT; k++)
+        {
+            if (motors[k].error >= 3 && motors[k].error != lastError[k])
+                trips[motors[k].error]++;
+            lastError[k] = motors[k].error;
+
+            if (startQueued(k) && !wasQueued[k])
+                queuedSince[k] = simElapsedMs;
+            wasQueued[k] = startQueued(k);
+            if (wasQueued[k] && (simElapsedMs - queuedSince[k]) / 1000.0 > maxQueuedSec[k])
+                maxQueuedSec[k] = (simElapsedMs - queuedSince[k]) / 1000.0;
+        }
+        int runningNow = 0;
+        for (uint8_t k = 0; k < MOTOR_COUNT; k++)
+            runningNow += motors[k].running;
+        if (runningNow > 1)
+            overlapSec += stepMs / 1000.0;
+
+        if (simElapsedMs - lastHeartbeat >= heartbeatMs)
+        {
+            lastHeartbeat = simElapsedMs;
+            journalEvent(EV_HEARTBEAT, 0);
+        }
+
+        if (simElapsedMs / 1000 != lastSampleSec)
+        {
+            // telemetryTick(): one sample per second
+            lastSampleSec = simElapsedMs / 1000;
+            TelemetryRow row;
+            row.first = epoch + (uint32_t)lastSampleSec;
+            int32_t values[TELEMETRY_FIELDS];
+            telemetrySample(values);
+            memcpy(row.second.data(), values, sizeof(values));
+            telemetry.append(row.first, values);
+            telemetryRows.push_back(row);
+            if (lastSampleSec % TELEMETRY_FLUSH_S == 0)
+                telemetry.flush();
+        }
+
+        stepPlant(stepMs / 1000.0);
+
+        // pzemTask polls the bus every tick (1 ms on target, 5 ms here) and the float timer fires
+        // every FLOAT_SAMPLE_MS while loop() runs
+        for (uint32_t t = 0; t < stepMs;)
+        {
+            uint32_t tick = stepMs - t < 5 ? stepMs - t : 5;
+            pzemBus.poll(simNow());
+            floatDue += tick;
+            if (floatDue >= FLOAT_SAMPLE_MS)
+            {
+                floatDue -= FLOAT_SAMPLE_MS;
+                floatInputs.sample(simFloatGpio(), simNow());
+                for (uint32_t diff = floatInputs.levels() ^ floatLevels; diff; diff &= diff - 1)
+                    floatChanges++;
+                floatLevels = floatInputs.levels();
+            }
+            simMillis += tick; // wraps at 2^32 exactly like millis()
+            simElapsedMs += tick;
+            t += tick;
+        }
+    }
+
+    printReport(days, (double)(clock() - wallStart) / CLOCKS_PER_SEC);
+    unsigned long bad = checkTelemetry(telemetry, telemetryRam, telemetryRows);
+    bad += checkJournal(heartbeatMs);
+    return bad ? 1 : 0;
+}